@@ -39,7 +39,11 @@ namespace Engine::Asset
         std::shared_ptr<T> instantiate_typed() const
         {
             static_assert(std::is_base_of<Engine::RuntimeObjectBase, T>::value, "T must derive from RuntimeObjectBase");
+#ifdef TETRA_NO_RTTI
+            return std::static_pointer_cast<T>(instantiate());
+#else
             return std::dynamic_pointer_cast<T>(instantiate());
+#endif
         }
 
     protected:
@@ -7,6 +7,11 @@
 
 // TODO: Implement a virtual file system for exports
 
+namespace Engine
+{
+    class JobSystem;
+}
+
 namespace Engine::Asset
 {
     class AssetManager : public Singleton<AssetManager>
@@ -17,7 +22,11 @@ namespace Engine::Asset
         AssetManager() = default;
         ~AssetManager() = default;
 
-        void init(const std::string &asset_root);
+        /**
+         * @brief Scans @p asset_root and registers every asset found in it.
+         * @param job_system If set, meta files are read and created on its workers.
+         */
+        void init(const std::string &asset_root, JobSystem *job_system = nullptr);
 
         template <typename T>
         std::shared_ptr<T> load(const std::string &path);
@@ -36,7 +45,8 @@ namespace Engine::Asset
         std::unordered_map<std::string, GUID> path_to_guid;
         std::unordered_map<GUID, std::shared_ptr<AssetBase>> loaded_assets;
 
-        void scan_assets();
+        void scan_assets(JobSystem *job_system);
+        AssetMeta read_or_create_meta(const std::string &asset_path) const;
         void register_asset(const AssetMeta &asset_meta);
     };
 
@@ -57,7 +67,13 @@ namespace Engine::Asset
 
         auto it = loaded_assets.find(guid);
         if (it != loaded_assets.end())
+        {
+#ifdef TETRA_NO_RTTI
+            return std::static_pointer_cast<T>(it->second);
+#else
             return std::dynamic_pointer_cast<T>(it->second);
+#endif
+        }
 
         auto meta_it = guid_to_meta.find(guid);
         if (meta_it == guid_to_meta.end())
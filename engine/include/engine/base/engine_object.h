@@ -4,6 +4,8 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 #include "engine/base/event.h"
 #include "engine/base/event_base.h"
@@ -13,11 +15,39 @@ namespace Engine
     class EngineObject : std::enable_shared_from_this<EngineObject>
     {
     public:
+        /// Events of an object and their subscribers, keyed by event name
+        using Subscribers = std::unordered_map<std::string, std::unique_ptr<EventBase>>;
+
         EngineObject();
         virtual ~EngineObject();
 
+        EngineObject(EngineObject &&) = default;
+        EngineObject &operator=(EngineObject &&) = default;
+
+        /// A copy is a new object: it gets a fresh instance ID and starts without event subscribers
+        EngineObject(const EngineObject &);
+
+        /// Keeps this object's instance ID and subscribers
+        EngineObject &operator=(const EngineObject &) { return *this; }
+
         size_t get_instance_id() const { return instance_id; }
 
+        /**
+         * @brief Makes this object the same object as @p source, for snapshots copied in place.
+         *
+         * Copies the instance ID. Subscribers are not part of the copied state, this object
+         * keeps its own, see take_subscribers() to move them along with the ID.
+         */
+        void copy_identity(const EngineObject &source) { instance_id = source.instance_id; }
+
+        bool has_subscribers() const { return !events.empty(); }
+
+        /**
+         * @brief Detaches every subscriber of this object, to hand them to another one with set_subscribers().
+         */
+        Subscribers take_subscribers() { return std::exchange(events, {}); }
+        void set_subscribers(Subscribers subscribers) { events = std::move(subscribers); }
+
         template <typename... Args>
         void subscribe(const std::string &event_name,
                        std::function<void(Args...)> callback)
@@ -43,7 +73,7 @@ namespace Engine
             // We know this EventBase really is Event<Args...>
             using EventType = Event<Args...>;
             auto *evt = static_cast<EventType *>(it->second.get());
-            evt->notify(args...);
+            evt->invoke(args...);
         }
 
     private:
@@ -68,6 +98,6 @@ namespace Engine
         size_t instance_id;
         static std::atomic<size_t> global_id_counter;
 
-        std::unordered_map<std::string, std::unique_ptr<EventBase>> events;
+        Subscribers events;
     };
 }
\ No newline at end of file
@@ -1,35 +1,47 @@
 #pragma once
 
 #include "engine/component/component_registry.h"
-#include "engine/graphics/viewport.h"
+#include "engine/graphics/frame_packet.h"
 #include "engine/math/vector3.h"
 #include "engine/math/matrix4.h"
 
-namespace Engine::Graphics
-{
-    class Viewport;
-}
-
 namespace Engine
 {
     using namespace Math;
 
+    class Transform3D;
+
     class Camera3D : public Component
     {
 
     public:
-        void update(float delta_time) override;
-        void setup() override;
-
-        virtual void render();
-        std::function<void(const Matrix4 &, const Matrix4 &)> on_render_scene;
-
-        Graphics::Viewport *get_viewport() { return viewport.get(); }
+        /**
+         * @brief Copies the camera's matrices and render callback into @p packet.
+         *
+         * The view matrix follows the world matrix of @p transform, so it is current once
+         * transforms have been propagated.
+         *
+         * The viewport the camera renders into belongs to RenderManager, so a camera is plain
+         * data and works the same in headless builds.
+         */
+        void extract(const Transform3D &transform, Graphics::CameraPacket &packet) const;
+
+        /**
+         * @brief Draws the scene, called with the camera's view and projection matrices.
+         *
+         * With pipelined rendering this runs on the render thread while the next simulation step
+         * runs, so it should only read the packet it is given.
+         */
+        Graphics::SceneRenderCallback on_render_scene;
 
         float get_fov_degrees() { return fov_degrees; }
         float get_near_plane() { return near_plane; }
         float get_far_plane() { return far_plane; }
 
+        int get_viewport_width() const { return viewport_width; }
+        int get_viewport_height() const { return viewport_height; }
+        void set_viewport_size(int width, int height);
+
         void deserialize(Serialization::SerializationContext &ctx) override { Component::serialize(ctx); }
         void serialize(Serialization::SerializationContext &ctx) const override { Component::serialize(ctx); }
 
@@ -38,9 +50,8 @@ namespace Engine
         float near_plane = 0.1f;
         float far_plane = 1000.0f;
 
-        std::unique_ptr<Graphics::Viewport> viewport;
-
-        void ensure_viewport(int width, int height);
+        int viewport_width = 1280;
+        int viewport_height = 720;
     };
 }
 
@@ -6,34 +6,99 @@
 #include "engine/math/quaternion.h"
 #include "engine/math/matrix4.h"
 
+#include <cstddef>
+
 namespace Engine
 {
     using namespace Math;
 
+    class TransformPropagation;
+
+    /**
+     * @brief Position, rotation and scale of an entity relative to its parent.
+     *
+     * Every setter marks the transform dirty. TransformPropagation recomputes the cached world
+     * matrix of dirty transforms and their descendants once per frame, so get_world_matrix()
+     * reflects changes made before the last Stage::update.
+     */
     class Transform3D : public Component
     {
+        friend class TransformPropagation;
+
     public:
         Transform3D() = default;
         ~Transform3D() = default;
 
-        Vector3 get_position() { return position; }
-        void set_position(const Vector3 &position) { this->position = position; }
+        Transform3D(Transform3D &&) = default;
+        Transform3D &operator=(Transform3D &&) = default;
+
+        Transform3D(const Transform3D &) = default;
+        Transform3D &operator=(const Transform3D &) = default;
 
-        Vector3 get_rotation_radians() { return rotation_radians; }
-        void set_rotation_radians(const Vector3 &rotation_degrees) { this->rotation_radians = rotation_degrees; }
+        Vector3 get_position() const { return position; }
+        void set_position(const Vector3 &position)
+        {
+            this->position = position;
+            mark_dirty();
+        }
 
-        Quaternion get_rotation() { return rotation; }
-        void set_rotation(const Quaternion &q) { rotation = q; }
+        /**
+         * @brief Euler angles (pitch, yaw, roll) in radians, kept only as an editing view of get_rotation().
+         */
+        Vector3 get_rotation_radians() const { return rotation_radians; }
+        void set_rotation_radians(const Vector3 &rotation_radians);
+
+        /**
+         * @brief Canonical rotation of the transform. Always normalized.
+         */
+        Quaternion get_rotation() const { return rotation; }
+        void set_rotation(const Quaternion &q);
+
+        Vector3 get_scale() const { return scale; }
+        void set_scale(const Vector3 &scale)
+        {
+            this->scale = scale;
+            mark_dirty();
+        }
 
         void translate(const Vector3 &delta);
         void rotate_degrees(const Vector3 &delta);
 
-        Vector3 get_forward() const;
-        Vector3 get_up() const;
-        Vector3 get_right() const;
+        // Basis vectors are read from the cached rotation matrix, no quaternion math per call
+        Vector3 get_forward() const { return Vector3(-rotation_matrix[2][0], -rotation_matrix[2][1], -rotation_matrix[2][2]); }
+        Vector3 get_up() const { return Vector3(rotation_matrix[1][0], rotation_matrix[1][1], rotation_matrix[1][2]); }
+        Vector3 get_right() const { return Vector3(rotation_matrix[0][0], rotation_matrix[0][1], rotation_matrix[0][2]); }
 
+        const Matrix4 &get_rotation_matrix() const { return rotation_matrix; }
         Matrix4 get_local_matrix() const;
 
+        /**
+         * @brief Writes get_local_matrix() of @p count consecutive transforms to @p out using the SIMD TRS kernel.
+         *
+         * Meant for whole component columns, e.g. ComponentColumn<Transform3D>::data().
+         * @see Math::compose_trs
+         */
+        static void compute_local_matrices(const Transform3D *transforms, size_t count, Matrix4 *out);
+
+        /**
+         * @brief Local matrix composed with every ancestor transform, as of the last propagation.
+         */
+        const Matrix4 &get_world_matrix() const { return world_matrix; }
+
+        /**
+         * @brief Whether the transform changed since its world matrix was last computed.
+         */
+        bool is_dirty() const { return dirty; }
+
+        /**
+         * @brief Flags the world matrix for recomputation and records the entity with its EntityManager,
+         *        so propagation only visits transforms that changed.
+         */
+        void mark_dirty();
+
+        /// New transforms start dirty and are recorded here, so propagation never scans for them
+        void on_attach() override;
+
         void serialize(Serialization::SerializationContext &ctx) const override;
         void deserialize(Serialization::SerializationContext &ctx) override;
 
@@ -42,6 +107,16 @@ namespace Engine
         Vector3 rotation_radians;
 
         Quaternion rotation;
+        Matrix4 rotation_matrix;
+
+        Vector3 scale = Vector3(1.0f);
+
+        // Derived cache written by TransformPropagation through const access, rebuilding it is not a change
+        mutable Matrix4 world_matrix;
+        mutable bool dirty = true;
+
+        // Rebuilds rotation_matrix after rotation changed
+        void refresh_rotation();
     };
 }
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "engine/entity/entity_id.h"
+
+namespace Engine::Math
+{
+    struct Matrix4;
+}
+
+namespace Engine
+{
+    class EntityManager;
+    class ComponentManager;
+
+    /**
+     * @brief Recomputes cached Transform3D world matrices along the entity hierarchy.
+     *
+     * Only the subtrees below changed transforms are visited. Transform3D::mark_dirty and
+     * Transform3D::on_attach record the entity with its EntityManager, and of those only the
+     * topmost dirty transform of each branch is walked, depth first through its children, so a
+     * static scene costs nothing beyond the recorded list. Entities without a Transform3D pass
+     * their parent's world matrix through. Transforms are only read, rebuilding their world
+     * matrices does not mark them changed for View::changed_since.
+     *
+     * When a parent link changed, the whole EntityHierarchy is walked once in breadth-first order
+     * instead, so every parent is resolved before its children.
+     *
+     * Stage::update runs it once per frame after structural changes are played back.
+     */
+    class TransformPropagation
+    {
+    public:
+        void run(EntityManager &entity_manager, ComponentManager &component_manager);
+
+    private:
+        uint64_t hierarchy_version = UINT64_MAX;
+
+        // Scratch arrays kept to avoid reallocating every frame
+        std::vector<const Math::Matrix4 *> world_matrices;
+        std::vector<EntityID> changed;
+        std::vector<std::pair<EntityID, const Math::Matrix4 *>> stack;
+
+        void propagate_all(EntityManager &entity_manager, ComponentManager &component_manager);
+        void propagate_subtree(EntityManager &entity_manager, ComponentManager &component_manager, EntityID root);
+    };
+}
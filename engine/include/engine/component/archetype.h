@@ -0,0 +1,133 @@
+#pragma once
+
+#include "engine/component/component_column.h"
+#include "engine/component/component_type.h"
+#include "engine/entity/entity_id.h"
+
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Storage for all entities that own exactly the same set of component types.
+     *
+     * Each component type gets its own contiguous column and every column shares the same
+     * row layout, so iterating a column is a linear sweep over tightly packed components.
+     * Rows are removed by swapping the last row into the hole, which keeps columns dense.
+     *
+     * Rows are partitioned: rows of active entities come first, rows of inactive ones follow
+     * from get_active_count() on, so hot loops can stop at the boundary.
+     */
+    class Archetype
+    {
+    public:
+        /**
+         * @param types Component types stored in this archetype, sorted ascending and unique.
+         */
+        explicit Archetype(std::vector<ComponentTypeID> types);
+
+        const std::vector<ComponentTypeID> &get_types() const { return types; }
+        const ComponentSignature &get_signature() const { return signature; }
+        const std::vector<EntityID> &get_entities() const { return entities; }
+
+        size_t size() const { return entities.size(); }
+
+        /**
+         * @brief Number of leading rows that belong to active entities.
+         */
+        size_t get_active_count() const { return active_count; }
+        size_t get_column_count() const { return columns.size(); }
+
+        bool has_type(ComponentTypeID type) const { return type < MAX_COMPONENT_TYPES && signature.test(type); }
+
+        /**
+         * @brief Checks whether this archetype stores every type set in @p required.
+         */
+        bool matches(const ComponentSignature &required) const { return (signature & required) == required; }
+
+        /**
+         * @brief Finds the column holding components of @p type.
+         * @return Column index, or -1 if this archetype does not store the type.
+         */
+        int get_column_index(ComponentTypeID type) const
+        {
+            return type < column_lookup.size() ? column_lookup[type] : -1;
+        }
+
+        ComponentColumnBase &get_column(size_t column_index) { return *columns[column_index]; }
+        const ComponentColumnBase &get_column(size_t column_index) const { return *columns[column_index]; }
+
+        /**
+         * @brief Returns the component of @p type stored at @p row, or nullptr if the type is not stored here.
+         */
+        Component *get_component(size_t row, ComponentTypeID type);
+
+        /**
+         * @brief Registers @p entity as the owner of a new row.
+         *
+         * The caller is responsible for appending exactly one component to every column.
+         * @return Index of the new row.
+         */
+        size_t push_entity(EntityID entity);
+
+        /**
+         * @brief Removes @p row from every column while keeping active rows in front.
+         *
+         * An active row is filled with the last active row, whose place is then filled with the
+         * last row. Up to two entities change rows, callers re-read get_entities() at @p row
+         * and at the old get_active_count() - 1.
+         */
+        void swap_remove(size_t row);
+
+        /**
+         * @brief Exchanges two rows in every column.
+         */
+        void swap_rows(size_t a, size_t b);
+
+        /**
+         * @brief Moves an inactive @p row to the end of the active range.
+         * @return The row it now occupies. The entity previously there moved to @p row.
+         */
+        size_t activate_row(size_t row);
+
+        /**
+         * @brief Moves the last @p count rows, all inactive, to the end of the active range in one pass.
+         * @return First row of the moved block, which stays contiguous. Inactive rows are reordered.
+         */
+        size_t activate_tail(size_t count);
+
+        /**
+         * @brief Moves an active @p row to the start of the inactive range.
+         * @return The row it now occupies. The entity previously there moved to @p row.
+         */
+        size_t deactivate_row(size_t row);
+
+        void reserve(size_t capacity);
+
+        /**
+         * @brief Replaces every row with a copy of the rows of @p source, an archetype with the same types.
+         */
+        void assign(const Archetype &source);
+
+        /**
+         * @brief Removes every row.
+         */
+        void clear();
+
+        /**
+         * @brief Bytes held by the rows, entity IDs and ticks included.
+         */
+        size_t get_byte_size() const;
+
+    private:
+        std::vector<ComponentTypeID> types;
+        ComponentSignature signature;
+        std::vector<std::unique_ptr<ComponentColumnBase>> columns;
+        std::vector<EntityID> entities;
+        size_t active_count = 0;
+
+        // Column index per ComponentTypeID, -1 where the type is not stored
+        std::vector<int> column_lookup;
+    };
+}
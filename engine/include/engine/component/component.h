@@ -1,6 +1,9 @@
 #pragma once
 
 #include "engine/component/component_id.h"
+#include "engine/component/component_handle.h"
+#include "engine/component/component_type.h"
+#include "engine/entity/entity_id.h"
 #include "engine/serialization/serializable.h"
 #include "engine/base/engine_object.h"
 
@@ -8,19 +11,63 @@ namespace Engine
 {
     class ComponentRegistry;
     class Entity;
+    class EntityManager;
+    class ReferenceRemap;
 
     class Component : public Serialization::Serializable, public EngineObject
     {
         friend class Entity;
         friend class ComponentManager;
+        friend class ComponentRegistry;
+        friend class CommandBuffer;
 
     public:
+        Component() = default;
         virtual ~Component() = default;
 
+        Component(Component &&) = default;
+        Component &operator=(Component &&) = default;
+
+        /// Copies carry the source's IDs until ComponentManager assigns their own, see Prefab
+        Component(const Component &) = default;
+        Component &operator=(const Component &) = default;
+
         virtual void update(float delta_time) {};
         virtual void setup() {};
 
-        ComponentID get_id() { return id; }
+        /**
+         * @brief Points entity IDs and handles held by this component at a freshly instantiated prefab copy.
+         *
+         * Only called for types that override it, once per component of every prefab instance.
+         */
+        virtual void remap_references(const ReferenceRemap & /*remap*/) {};
+
+        /**
+         * @brief Called once the component is stored for its owner, whether created, copied from a prefab or loaded.
+         */
+        virtual void on_attach() {};
+
+        ComponentID get_id() const { return id; }
+
+        /**
+         * @brief Dense registered type of this component, assigned when it is created.
+         */
+        ComponentTypeID get_type_id() const { return type_id; }
+
+        /**
+         * @brief Returns a handle that keeps referring to this component across archetype moves.
+         */
+        ComponentHandle<Component> get_handle() const { return {id, type_id}; }
+
+        /**
+         * @brief Disabled components are skipped by setup and update but keep their data.
+         *
+         * Independent of the owning entity, whose inactive state also stops its components. Unlike
+         * inactive entities, disabled components keep their row in the active range, loops skip them
+         * with a per-row check.
+         */
+        bool is_enabled() const { return enabled; }
+        void set_enabled(bool enabled) { this->enabled = enabled; }
 
         void serialize(Serialization::SerializationContext &ctx) const override
         {
@@ -29,8 +76,11 @@ namespace Engine
             ctx.end_object();
 
             ctx.begin_object_key("owner_id");
-            id.serialize(ctx);
+            owner_id.serialize(ctx);
             ctx.end_object();
+
+            if (!enabled)
+                ctx.write("enabled", false);
         }
 
         void deserialize(Serialization::SerializationContext &ctx) override
@@ -40,17 +90,35 @@ namespace Engine
             ctx.end_object();
 
             ctx.begin_object_key("owner_id");
-            id.deserialize(ctx);
+            owner_id.deserialize(ctx);
             ctx.end_object();
+
+            enabled = !ctx.has_key("enabled") || ctx.read<bool>("enabled");
         }
 
-        const Entity *get_entity() const { return entity; }
+        /**
+         * @brief Resolves the owning entity through its EntityManager.
+         * @return The owner, or nullptr if it has been destroyed.
+         */
+        const Entity *get_entity() const;
+        EntityID get_owner_id() const { return owner_id; }
 
     protected:
         ComponentID id;
-        const Entity *entity = nullptr;
+        EntityID owner_id = EntityID::Invalid;
+        EntityManager *entity_manager = nullptr;
 
     private:
-        void set_entity(const Entity *entity) { this->entity = entity; }
+        ComponentTypeID type_id = INVALID_COMPONENT_TYPE;
+        bool enabled = true;
+
+        // Every path that stores a component for a new owner goes through here
+        void set_owner(EntityManager *entity_manager, EntityID owner_id)
+        {
+            this->entity_manager = entity_manager;
+            this->owner_id = owner_id;
+
+            on_attach();
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "engine/component/component.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Type-erased interface over a contiguous array of one component type.
+     *
+     * Archetypes hold one column per component type. All columns of an archetype share row
+     * indices, so row N of every column belongs to the same entity.
+     *
+     * Next to the components, every column keeps two parallel tick arrays: the tick a row's
+     * component was added at and the tick it was last handed out for writing. Ticks come from
+     * ComponentManager::get_tick() and survive moves between archetypes.
+     */
+    class ComponentColumnBase
+    {
+    public:
+        virtual ~ComponentColumnBase() = default;
+
+        virtual size_t size() const = 0;
+        virtual void reserve(size_t capacity) = 0;
+        virtual void clear() = 0;
+
+        virtual Component *get(size_t row) = 0;
+
+        /**
+         * @brief Appends a default constructed component, added and changed at @p tick.
+         * @return The appended component.
+         */
+        virtual Component *emplace_default(uint32_t tick) = 0;
+
+        /**
+         * @brief Appends @p count default constructed components with a single allocation.
+         */
+        virtual void emplace_defaults(size_t count, uint32_t tick) = 0;
+
+        /**
+         * @brief Appends a component by moving it out of @p source, which must be of this column's type.
+         * @return The appended component.
+         */
+        virtual Component *push_moved(Component &source, uint32_t tick) = 0;
+
+        /**
+         * @brief Appends a component by moving row @p row out of another column of the same type, keeping its ticks.
+         * @return The appended component.
+         */
+        virtual Component *push_moved_from(ComponentColumnBase &source, size_t row) = 0;
+
+        /**
+         * @brief Whether the component type can be copied, which push_copy and append_copies need.
+         */
+        virtual bool is_copyable() const = 0;
+
+        /**
+         * @brief Appends a copy of row @p row of another column of the same type, added and changed at @p tick.
+         */
+        virtual Component *push_copy(const ComponentColumnBase &source, size_t row, uint32_t tick) = 0;
+
+        /**
+         * @brief Appends every component of @p source, a column of the same type, @p times over in one allocation.
+         */
+        virtual void append_copies(const ComponentColumnBase &source, size_t times, uint32_t tick) = 0;
+
+        /**
+         * @brief Replaces every row, ticks included, with copies of @p source, a column of the same type.
+         *
+         * Unlike copy construction the copies keep the instance IDs of the source rows, so a
+         * restored snapshot holds the same objects. Reuses the existing allocation when it is
+         * large enough.
+         */
+        virtual void assign(const ComponentColumnBase &source) = 0;
+
+        /**
+         * @brief Bytes held by the stored components and their ticks.
+         */
+        virtual size_t get_byte_size() const = 0;
+
+        /**
+         * @brief Removes @p row by moving the last element into it.
+         */
+        virtual void swap_remove(size_t row) = 0;
+
+        /**
+         * @brief Exchanges the components and ticks of two rows.
+         */
+        virtual void swap_rows(size_t a, size_t b) = 0;
+
+        /**
+         * @brief Creates an empty column of the same component type.
+         */
+        virtual std::unique_ptr<ComponentColumnBase> create_empty() const = 0;
+
+        uint32_t get_added_tick(size_t row) const { return added_ticks[row]; }
+        uint32_t get_changed_tick(size_t row) const { return changed_ticks[row]; }
+
+        void mark_changed(size_t row, uint32_t tick) { changed_ticks[row] = tick; }
+
+        const uint32_t *get_added_ticks() const { return added_ticks.data(); }
+        uint32_t *get_changed_ticks() { return changed_ticks.data(); }
+        const uint32_t *get_changed_ticks() const { return changed_ticks.data(); }
+
+    protected:
+        void reserve_ticks(size_t capacity)
+        {
+            added_ticks.reserve(capacity);
+            changed_ticks.reserve(capacity);
+        }
+
+        void clear_ticks()
+        {
+            added_ticks.clear();
+            changed_ticks.clear();
+        }
+
+        void push_ticks(uint32_t added, uint32_t changed)
+        {
+            added_ticks.push_back(added);
+            changed_ticks.push_back(changed);
+        }
+
+        void swap_row_ticks(size_t a, size_t b)
+        {
+            std::swap(added_ticks[a], added_ticks[b]);
+            std::swap(changed_ticks[a], changed_ticks[b]);
+        }
+
+        void assign_ticks(const ComponentColumnBase &source)
+        {
+            added_ticks = source.added_ticks;
+            changed_ticks = source.changed_ticks;
+        }
+
+        void swap_remove_ticks(size_t row)
+        {
+            added_ticks[row] = added_ticks.back();
+            changed_ticks[row] = changed_ticks.back();
+
+            added_ticks.pop_back();
+            changed_ticks.pop_back();
+        }
+
+    private:
+        std::vector<uint32_t> added_ticks;
+        std::vector<uint32_t> changed_ticks;
+    };
+
+    template <typename T>
+    class ComponentColumn : public ComponentColumnBase
+    {
+    public:
+        size_t size() const override { return components.size(); }
+        void reserve(size_t capacity) override
+        {
+            components.reserve(capacity);
+            reserve_ticks(capacity);
+        }
+
+        void clear() override
+        {
+            components.clear();
+            clear_ticks();
+        }
+
+        Component *get(size_t row) override { return &components[row]; }
+
+        T *data() { return components.data(); }
+        const T *data() const { return components.data(); }
+
+        Component *emplace_default(uint32_t tick) override
+        {
+            push_ticks(tick, tick);
+            return &components.emplace_back();
+        }
+
+        void emplace_defaults(size_t count, uint32_t tick) override
+        {
+            components.resize(components.size() + count);
+
+            for (size_t i = 0; i < count; i++)
+                push_ticks(tick, tick);
+        }
+
+        Component *push_moved(Component &source, uint32_t tick) override
+        {
+            push_ticks(tick, tick);
+            return &components.emplace_back(std::move(static_cast<T &>(source)));
+        }
+
+        Component *push_moved_from(ComponentColumnBase &source, size_t row) override
+        {
+            auto &typed_source = static_cast<ComponentColumn<T> &>(source);
+
+            push_ticks(source.get_added_tick(row), source.get_changed_tick(row));
+            return &components.emplace_back(std::move(typed_source.components[row]));
+        }
+
+        bool is_copyable() const override { return std::is_copy_constructible_v<T>; }
+
+        Component *push_copy(const ComponentColumnBase &source, size_t row, uint32_t tick) override
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                const auto &typed_source = static_cast<const ComponentColumn<T> &>(source);
+
+                push_ticks(tick, tick);
+                return &components.emplace_back(typed_source.components[row]);
+            }
+            else
+                throw std::runtime_error("Component type is not copyable");
+        }
+
+        void append_copies(const ComponentColumnBase &source, size_t times, uint32_t tick) override
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                const auto &typed_source = static_cast<const ComponentColumn<T> &>(source);
+                const std::vector<T> &copied = typed_source.components;
+
+                components.reserve(components.size() + copied.size() * times);
+                for (size_t i = 0; i < times; i++)
+                    components.insert(components.end(), copied.begin(), copied.end());
+
+                for (size_t i = 0; i < copied.size() * times; i++)
+                    push_ticks(tick, tick);
+            }
+            else
+                throw std::runtime_error("Component type is not copyable");
+        }
+
+        void assign(const ComponentColumnBase &source) override
+        {
+            if constexpr (std::is_copy_assignable_v<T>)
+            {
+                const std::vector<T> &source_components = static_cast<const ComponentColumn<T> &>(source).components;
+                components = source_components;
+
+                for (size_t row = 0; row < components.size(); row++)
+                    components[row].copy_identity(source_components[row]);
+
+                assign_ticks(source);
+            }
+            else
+                throw std::runtime_error("Component type is not copyable");
+        }
+
+        size_t get_byte_size() const override { return components.size() * (sizeof(T) + 2 * sizeof(uint32_t)); }
+
+        void swap_remove(size_t row) override
+        {
+            if (row + 1 != components.size())
+                components[row] = std::move(components.back());
+
+            components.pop_back();
+            swap_remove_ticks(row);
+        }
+
+        void swap_rows(size_t a, size_t b) override
+        {
+            if (a == b)
+                return;
+
+            std::swap(components[a], components[b]);
+            swap_row_ticks(a, b);
+        }
+
+        std::unique_ptr<ComponentColumnBase> create_empty() const override
+        {
+            return std::make_unique<ComponentColumn<T>>();
+        }
+
+    private:
+        std::vector<T> components;
+    };
+}
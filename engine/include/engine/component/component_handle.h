@@ -0,0 +1,66 @@
+#pragma once
+
+#include "engine/component/component_id.h"
+#include "engine/component/component_type.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace Engine
+{
+    class Component;
+
+    /**
+     * @brief Non-owning reference to a component, resolved through its ComponentManager.
+     *
+     * A handle is a generational ComponentID plus the registered type ID, so copying one is
+     * a plain copy and a stale handle resolves to nullptr instead of dangling. Unlike raw
+     * component pointers, handles stay valid across archetype moves.
+     *
+     * @tparam T Component type the handle resolves to, Component for a type-erased handle.
+     */
+    template <typename T>
+    struct ComponentHandle
+    {
+        ComponentID id = ComponentID::Invalid;
+        ComponentTypeID type_id = INVALID_COMPONENT_TYPE;
+
+        ComponentHandle() = default;
+        ComponentHandle(ComponentID id, ComponentTypeID type_id) : id(id), type_id(type_id) {}
+
+        /// Handles of a concrete type convert to handles of its bases
+        template <typename U, typename = std::enable_if_t<std::is_base_of_v<T, U> && !std::is_same_v<T, U>>>
+        ComponentHandle(const ComponentHandle<U> &other) : id(other.id), type_id(other.type_id) {}
+
+        bool is_valid() const { return id.is_valid() && type_id != INVALID_COMPONENT_TYPE; }
+
+        bool operator==(const ComponentHandle &other) const { return id == other.id && type_id == other.type_id; }
+        bool operator!=(const ComponentHandle &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Narrows a type-erased handle to T.
+     * @return The handle, or an invalid handle if it does not refer to a T.
+     */
+    template <typename T>
+    ComponentHandle<T> handle_cast(const ComponentHandle<Component> &handle)
+    {
+        if (handle.type_id == INVALID_COMPONENT_TYPE || handle.type_id != component_type_id<T>())
+            return {};
+
+        return {handle.id, handle.type_id};
+    }
+}
+
+namespace std
+{
+    template <typename T>
+    struct hash<Engine::ComponentHandle<T>>
+    {
+        std::size_t operator()(const Engine::ComponentHandle<T> &handle) const noexcept
+        {
+            return std::hash<Engine::ComponentID>()(handle.id);
+        }
+    };
+}
@@ -6,65 +6,411 @@
 #include "engine/data/guid.h"
 #include "engine/base/event.h"
 #include "engine/component/component.h"
+#include "engine/component/component_type.h"
+#include "engine/component/archetype.h"
+#include "engine/component/component_registry.h"
+#include "engine/component/component_view.h"
 
 #include <iostream>
-#include <unordered_map>
 #include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine
 {
     class Component;
     class ComponentRegistry;
+    class Prefab;
 
+    /**
+     * @brief Owns all components of a stage in archetype storage.
+     *
+     * Entities that have the same set of component types share an Archetype, which keeps one
+     * contiguous column per type. Adding or removing a component moves the entity's row to the
+     * archetype matching its new type set.
+     *
+     * Component pointers handed out by this manager are only valid until the next structural
+     * change (adding or removing components or entities) touches the archetype they live in.
+     * Store the ComponentID when a reference has to outlive that.
+     *
+     * Every component records the tick it was added at and the tick it was last handed out
+     * mutably. Accessors returning non-const components (get_component, resolve,
+     * for_each_component, views over non-const types) stamp the current tick; read_component
+     * and views over const types do not. View::changed_since and View::added_since filter on
+     * these ticks.
+     */
     class ComponentManager : public Serialization::Serializable
     {
         friend class Stage;
+        friend class Prefab;
 
     public:
         ComponentManager(Stage *owner_stage_ptr);
-        ~ComponentManager() = default;
+        ~ComponentManager();
+
+        /// Fired after a component is added, the handle resolves for the rest of the frame
+        Event<ComponentHandle<Component>> component_created;
+
+        /// Fired before a component is destroyed, the handle still resolves inside the callback
+        Event<ComponentHandle<Component>> component_destroyed;
+
+        /// Rows appended to one archetype by create_components
+        struct ComponentBatch
+        {
+            uint32_t archetype;
+            size_t first_row;
+            size_t count;
+        };
+
+        /**
+         * @brief Fired once per create_components call, which does not fire component_created.
+         */
+        Event<const ComponentBatch &> components_created_batch;
+
+        /**
+         * @brief Adds a default constructed component of type T to an entity.
+         *
+         * @tparam T Registered component type.
+         * @param owner_id Entity to attach the component to. Must not already own a T.
+         * @return Pointer to the new component.
+         */
+        template <typename T>
+        T *create_component(EntityID owner_id);
+
+        /**
+         * @brief Adds a default constructed component of a registered type to an entity.
+         */
+        Component *create_component(EntityID owner_id, ComponentTypeID type_id);
+
+        /**
+         * @brief Gives each of @p count entities a default constructed component of every type in @p signature.
+         *
+         * The entities must not own any components yet. Storage for all of them is reserved up
+         * front and the components are constructed in one pass per column.
+         */
+        void create_components(const EntityID *owner_ids, size_t count, const ComponentSignature &signature);
+
+        /**
+         * @brief Gives new prefab instances copies of the prefab's components.
+         *
+         * @p owner_ids holds @p count times Prefab::get_entity_count() entities without components,
+         * instance after instance in prefab order. Each prefab archetype is appended to its target
+         * archetype column by column, then references are remapped per instance. Fires
+         * components_created_batch once per target archetype.
+         */
+        void instantiate_components(const Prefab &prefab, const EntityID *owner_ids, size_t count);
+
+        /// A component to add in a batched change, moved out of @p source or default constructed if null
+        struct PendingComponent
+        {
+            ComponentTypeID type = INVALID_COMPONENT_TYPE;
+            Component *source = nullptr;
+        };
+
+        /**
+         * @brief Removes and adds several components with a single archetype move.
+         *
+         * Types in @p added that the entity already owns and does not remove are skipped.
+         * Destroyed events fire before the move, created events after it.
+         *
+         * @param removed Component types to destroy, types the entity does not own are ignored.
+         * @param added Components to add, each type at most once.
+         */
+        void apply_changes(EntityID owner_id, const ComponentSignature &removed, const std::vector<PendingComponent> &added);
+
+        /**
+         * @brief Returns the entity's T for writing and marks it changed at the current tick.
+         */
+        template <typename T>
+        T *get_component(EntityID owner_id);
+
+        Component *get_component(EntityID owner_id, ComponentTypeID type_id);
+
+        /**
+         * @brief Returns the entity's T without marking it changed.
+         */
+        template <typename T>
+        const T *read_component(EntityID owner_id) const;
 
-        Event<std::weak_ptr<Component>> component_created;
-        Event<std::weak_ptr<Component>> component_destroyed;
+        const Component *read_component(EntityID owner_id, ComponentTypeID type_id) const;
+
+        /**
+         * @brief Marks the entity's component of @p type_id changed at the current tick.
+         * @return false if the entity has no such component.
+         */
+        bool mark_changed(EntityID owner_id, ComponentTypeID type_id);
+
+        template <typename T>
+        bool mark_changed(EntityID owner_id)
+        {
+            return mark_changed(owner_id, component_type_id<T>());
+        }
+
+        /**
+         * @brief Current change tick, starting at 1.
+         *
+         * Stage::update advances it at the start of every frame and after every system layer,
+         * so a system that records the tick it ran at sees every later write as newer.
+         */
+        uint32_t get_tick() const { return current_tick; }
+        uint32_t advance_tick() { return ++current_tick; }
+
+        /**
+         * @brief Tests the entity's signature bit for @p type_id.
+         *
+         * @p owner_id must refer to a live entity, a stale ID answers for whichever entity reuses its index.
+         */
+        bool has_component(EntityID owner_id, ComponentTypeID type_id) const
+        {
+            return owner_id.index < entity_signatures.size() && type_id < MAX_COMPONENT_TYPES &&
+                   entity_signatures[owner_id.index].test(type_id);
+        }
 
         template <typename T>
-        std::shared_ptr<Component> create_component(EntityID owner_id);
+        bool has_component(EntityID owner_id) const
+        {
+            return has_component(owner_id, component_type_id<T>());
+        }
+
+        /**
+         * @brief Returns the set of component types the entity owns, empty for unknown entities.
+         */
+        ComponentSignature get_signature(EntityID owner_id) const;
 
         void destroy_component(const ComponentID id);
-        Component *get_component_by_id(const ComponentID id) const;
+        Component *get_component_by_id(const ComponentID id);
+
+        /**
+         * @brief Returns the component with @p id without marking it changed.
+         */
+        const Component *read_component_by_id(const ComponentID id) const;
+
+        /**
+         * @brief Resolves a handle to its component.
+         * @return The component, or nullptr if it was destroyed or is not a T.
+         */
+        template <typename T>
+        T *resolve(const ComponentHandle<T> &handle);
 
+        /**
+         * @brief Resolves a handle to its component without marking it changed.
+         * @return The component, or nullptr if it was destroyed or is not a T.
+         */
         template <typename T>
-        std::vector<std::weak_ptr<T>> get_components_by_type() const
+        const T *read_component(const ComponentHandle<T> &handle) const;
+
+        /**
+         * @brief Returns a handle to the entity's T, or an invalid handle if it has none.
+         */
+        template <typename T>
+        ComponentHandle<T> get_handle(EntityID owner_id) const;
+
+        /**
+         * @brief Destroys every component owned by the entity.
+         */
+        void remove_entity(EntityID owner_id);
+
+        /**
+         * @brief Moves the entity's row into the active or inactive range of its archetype.
+         *
+         * Called by EntityManager when the entity's effective state changes. Rows of inactive
+         * entities are skipped by views and by update_components.
+         */
+        void set_entity_active(EntityID owner_id, bool active);
+
+        bool is_entity_active(EntityID owner_id) const
         {
-            static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+            return owner_id.index >= entity_inactive.size() || !entity_inactive[owner_id.index];
+        }
+
+        /// Calls setup on the entity's enabled components
+        void setup_entity(EntityID owner_id);
+
+        /// Calls update on the entity's enabled components
+        void update_entity(EntityID owner_id, float delta_time);
+
+        /**
+         * @brief Updates every component type by type, one tight loop per column.
+         *
+         * Only types that override Component::update are visited, and their update is called
+         * without virtual dispatch. Types run in registration order. Rows of inactive entities
+         * are not visited and disabled components are skipped.
+         */
+        void update_components(float delta_time);
+
+        template <typename T>
+        std::vector<T *> get_components_by_type();
+
+        /**
+         * @brief Calls @p func with a reference to every component of type T.
+         *
+         * Walks only the columns that store T, so the cost depends on the number of T
+         * components and never allocates. Do not add or remove components from @p func.
+         *
+         * @tparam T Registered component type.
+         * @param func Callable taking T &.
+         */
+        template <typename T, typename Func>
+        void for_each_component(Func &&func);
+
+        /**
+         * @brief Returns every entity that owns all component types set in @p required.
+         *
+         * Matching is a bitwise AND of @p required against each archetype signature, so the
+         * cost depends on the number of archetypes and matching entities.
+         */
+        std::vector<EntityID> get_entities_with(const ComponentSignature &required) const;
+
+        template <typename... Ts>
+        std::vector<EntityID> get_entities_with() const;
+
+        /**
+         * @brief Returns a view over every entity that owns all of Ts.
+         *
+         * The archetypes matching a signature are cached on first use and extended whenever a
+         * new archetype is created, so repeated views never rescan the stage. Const qualified
+         * types are yielded as const references and are not marked changed.
+         */
+        template <typename... Ts>
+        View<Ts...> view();
 
-            std::vector<std::weak_ptr<T>> filtered_components;
+        /**
+         * @brief Returns the indices of the archetypes storing every type in @p required.
+         *
+         * The returned list is cached, stays valid for the lifetime of this manager and is
+         * updated in place as archetypes are created. Safe to call from concurrently running
+         * systems as long as none of them makes structural changes.
+         */
+        const std::vector<uint32_t> &get_matching_archetypes(const ComponentSignature &required);
 
-            for (const auto &[id, component] : component_list)
-            {
-                auto casted = std::dynamic_pointer_cast<T>(component);
-                if (casted)
-                    filtered_components.push_back(casted);
-            }
+        /**
+         * @brief Returns how many components of the given type currently exist.
+         */
+        size_t get_component_count(ComponentTypeID type_id) const;
 
-            return filtered_components;
+        template <typename T>
+        size_t get_component_count() const
+        {
+            return get_component_count(component_type_id<T>());
         }
 
+        /**
+         * @brief Returns the registered type of a component, or INVALID_COMPONENT_TYPE if the ID is stale.
+         */
+        ComponentTypeID get_component_type(const ComponentID id) const;
+
+        const std::vector<std::unique_ptr<Archetype>> &get_archetypes() const { return archetypes; }
+
         void resolve_references();
 
+        /// Copy of every row and ID table, filled by capture and applied by restore
+        struct Snapshot;
+
+        /**
+         * @brief Copies all component storage into @p snapshot, reusing its allocations from earlier captures.
+         */
+        void capture(Snapshot &snapshot) const;
+
+        /**
+         * @brief Puts every component back as it was when @p snapshot was captured.
+         *
+         * Archetypes created since then are emptied, not removed, so cached views stay valid. No
+         * events fire and the tick is not rewound, restored rows keep the ticks they had. Restored
+         * components keep their instance IDs, and event subscribers stay with the component of
+         * the same instance ID wherever its row moved. Throws if the archetype layout was
+         * replaced in between, e.g. by deserialize.
+         */
+        void restore(const Snapshot &snapshot);
+
         void serialize(Serialization::SerializationContext &ctx) const override;
         void deserialize(Serialization::SerializationContext &ctx) override;
 
         ComponentID allocate_id();
 
     private:
-        std::unordered_map<ComponentID, std::shared_ptr<Component>> component_list;
+        static constexpr uint32_t INVALID_ARCHETYPE = UINT32_MAX;
+
+        struct EntityLocation
+        {
+            uint32_t archetype = INVALID_ARCHETYPE;
+            uint32_t row = 0;
+        };
+
+        /// One column that stores a given component type
+        struct PoolEntry
+        {
+            uint32_t archetype;
+            uint32_t column;
+        };
+
+        struct ComponentRecord
+        {
+            EntityID owner = EntityID::Invalid;
+            ComponentTypeID type = INVALID_COMPONENT_TYPE;
+        };
+
+        std::vector<std::unique_ptr<Archetype>> archetypes;
+        std::unordered_map<ComponentSignature, uint32_t> archetype_lookup;
+
+        // Matching archetype indices per queried signature, kept current by get_or_create_archetype
+        std::unordered_map<ComponentSignature, std::vector<uint32_t>> query_cache;
+        std::shared_mutex query_cache_mutex;
 
+        // Per-type pools indexed by ComponentTypeID, listing every column that stores the type
+        std::vector<std::vector<PoolEntry>> component_pools;
+
+        // Indexed by EntityID::index
+        std::vector<EntityLocation> entity_locations;
+        std::vector<ComponentSignature> entity_signatures;
+        std::vector<uint8_t> entity_inactive;
+
+        // Indexed by ComponentID::index
+        std::vector<ComponentRecord> component_records;
         std::vector<uint32_t> generations;
         std::vector<uint32_t> free_indices;
 
         Stage *stage = nullptr;
+
+        uint32_t current_tick = 1;
+
+        const EntityLocation *find_location(EntityID owner_id) const;
+        uint32_t get_or_create_archetype(const ComponentSignature &signature);
+        void set_location(EntityID owner_id, uint32_t archetype_index, uint32_t row);
+        void refresh_row(uint32_t archetype_index, size_t row);
+        void clear_location(EntityID owner_id);
+
+        /**
+         * @brief Moves the entity into the archetype that also stores @p type_id and appends the new component.
+         *
+         * @param source If set, the new component is moved out of it, otherwise it is default constructed.
+         */
+        Component *attach_component(EntityID owner_id, ComponentTypeID type_id, Component *source);
+
+        /**
+         * @brief Moves the entity into the archetype without @p type_id, destroying that component.
+         */
+        void detach_component(EntityID owner_id, ComponentTypeID type_id);
+
+        void remove_row(uint32_t archetype_index, uint32_t row);
+        void release_id(ComponentID id);
+    };
+
+    struct ComponentManager::Snapshot
+    {
+        std::vector<std::unique_ptr<Archetype>> archetypes;
+
+        std::vector<EntityLocation> entity_locations;
+        std::vector<ComponentSignature> entity_signatures;
+        std::vector<uint8_t> entity_inactive;
+
+        std::vector<ComponentRecord> component_records;
+        std::vector<uint32_t> generations;
+        std::vector<uint32_t> free_indices;
+
+        size_t get_byte_size() const;
     };
 }
 
-#include "engine/component/component_manager.inl"
\ No newline at end of file
+#include "engine/component/component_manager.inl"
+#include "engine/stage/stage.inl"
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "engine/component/component.h"
+#include "engine/component/component_column.h"
 #include "engine/entity/entity_manager.h"
 #include "engine/entity/entity.h"
 #include "engine/component/component_registry.h"
@@ -11,29 +12,138 @@
 namespace Engine
 {
     template <typename T>
-    std::shared_ptr<Component> ComponentManager::create_component(EntityID owner_id)
+    T *ComponentManager::create_component(EntityID owner_id)
     {
         static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
 
-        Entity *entity = stage->get_entity_manager().get_entity_by_id(owner_id);
-
-        if (!entity)
+        ComponentTypeID type_id = component_type_id<T>();
+        if (type_id == INVALID_COMPONENT_TYPE)
         {
-            throw std::runtime_error("Cannot find entity with provided EntityID!");
+            throw std::runtime_error("Component type is not registered in ComponentRegistry!");
         }
 
-        ComponentID component_id = allocate_id();
+        return static_cast<T *>(create_component(owner_id, type_id));
+    }
+
+    template <typename T>
+    T *ComponentManager::get_component(EntityID owner_id)
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+
+        ComponentTypeID type_id = component_type_id<T>();
+        if (type_id == INVALID_COMPONENT_TYPE)
+            return nullptr;
+
+        return static_cast<T *>(get_component(owner_id, type_id));
+    }
+
+    template <typename T>
+    const T *ComponentManager::read_component(EntityID owner_id) const
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+
+        ComponentTypeID type_id = component_type_id<T>();
+        if (type_id == INVALID_COMPONENT_TYPE)
+            return nullptr;
+
+        return static_cast<const T *>(read_component(owner_id, type_id));
+    }
+
+    template <typename T>
+    T *ComponentManager::resolve(const ComponentHandle<T> &handle)
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+
+        if (!handle.is_valid() || get_component_type(handle.id) != handle.type_id)
+            return nullptr;
+
+        return static_cast<T *>(get_component_by_id(handle.id));
+    }
+
+    template <typename T>
+    const T *ComponentManager::read_component(const ComponentHandle<T> &handle) const
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+
+        if (!handle.is_valid() || get_component_type(handle.id) != handle.type_id)
+            return nullptr;
 
-        ComponentRegistry &component_registry = ComponentRegistry::get_instance();
-        std::shared_ptr<T> component_ptr = component_registry.instantiate_raw_typed<T>();
+        return static_cast<const T *>(read_component_by_id(handle.id));
+    }
+
+    template <typename T>
+    ComponentHandle<T> ComponentManager::get_handle(EntityID owner_id) const
+    {
+        const T *component = read_component<T>(owner_id);
+        if (!component)
+            return {};
+
+        return {component->get_id(), component->get_type_id()};
+    }
+
+    template <typename T>
+    std::vector<T *> ComponentManager::get_components_by_type()
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+
+        std::vector<T *> filtered_components;
+
+        ComponentTypeID type_id = component_type_id<T>();
+        if (type_id == INVALID_COMPONENT_TYPE)
+            return filtered_components;
+
+        filtered_components.reserve(get_component_count(type_id));
+
+        for_each_component<T>([&](T &component)
+                              { filtered_components.push_back(&component); });
+
+        return filtered_components;
+    }
+
+    template <typename... Ts>
+    std::vector<EntityID> ComponentManager::get_entities_with() const
+    {
+        ComponentSignature required;
+        if (!make_component_signature<Ts...>(required))
+            return {};
+
+        return get_entities_with(required);
+    }
+
+    template <typename... Ts>
+    View<Ts...> ComponentManager::view()
+    {
+        static const std::vector<uint32_t> no_matches;
 
-        component_ptr->id = component_id;
-        component_ptr->entity = entity;
+        ComponentSignature required;
+        if (!make_component_signature<Ts...>(required))
+            return View<Ts...>(&archetypes, &no_matches, current_tick);
 
-        component_list[component_id] = component_ptr;
+        return View<Ts...>(&archetypes, &get_matching_archetypes(required), current_tick);
+    }
+
+    template <typename T, typename Func>
+    void ComponentManager::for_each_component(Func &&func)
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
 
-        component_created.invoke(component_ptr);
+        ComponentTypeID type_id = component_type_id<T>();
+        if (type_id >= component_pools.size())
+            return;
 
-        return component_list[component_id];
+        for (const PoolEntry &entry : component_pools[type_id])
+        {
+            auto &column = static_cast<ComponentColumn<T> &>(archetypes[entry.archetype]->get_column(entry.column));
+
+            T *components = column.data();
+            uint32_t *changed_ticks = column.get_changed_ticks();
+            size_t count = column.size();
+
+            for (size_t row = 0; row < count; row++)
+            {
+                changed_ticks[row] = current_tick;
+                func(components[row]);
+            }
+        }
     }
 }
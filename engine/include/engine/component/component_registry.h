@@ -2,14 +2,17 @@
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <string>
 #include <unordered_map>
-#include <typeinfo>
-#include <typeindex>
+#include <vector>
 #include <cassert>
 
 #include "engine/base/singleton.h"
 #include "engine/debug/logging/logger.h"
+#include "engine/component/component_column.h"
+#include "engine/component/component_type.h"
 #include "component.h"
 
 namespace Engine
@@ -30,111 +33,151 @@ namespace Engine
          */
         std::string get_name(const Component *component) const;
 
-        /**
-         * @brief Get the names for all registered components with types.
-         * @return Unordered list with types as keys and their names as values.
-         */
-        std::unordered_map<std::type_index, std::string> get_type_names() const { return type_names; }
-
         /**
          * @brief Register a component type T with a unique string name.
          *
+         * Registering the same type again is a no-op, so the registration macro can live in headers.
+         *
          * @tparam T Concrete component type, must derive from Component.
          * @param name Unique name for serialization.
+         * @return The dense type ID assigned to T.
          */
         template <typename T>
-        void register_type(const std::string &name)
+        ComponentTypeID register_type(const std::string &name)
         {
             static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+            static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+            static_assert(std::is_move_constructible<T>::value && std::is_move_assignable<T>::value,
+                          "T must be movable to be stored in archetype columns");
+
+            ComponentTypeID &type_id = ComponentTypeIndex<T>::value;
+            if (type_id != INVALID_COMPONENT_TYPE)
+                return type_id;
+
+            if (type_infos.size() >= MAX_COMPONENT_TYPES)
+                throw std::runtime_error("Cannot register " + name + ", component type limit reached");
 
             Logger::log_info("[ComponentRegistry] Registered component with name " + name);
 
-            std::type_index type_index(typeid(T));
-            creators[name] = []()
-            { return std::make_unique<T>(); };
+            type_id = static_cast<ComponentTypeID>(type_infos.size());
 
-            type_names[type_index] = name;
-        }
+            creators[name] = []() -> std::unique_ptr<Component>
+            {
+                std::unique_ptr<T> component = std::make_unique<T>();
+                component->type_id = ComponentTypeIndex<T>::value;
+                return component;
+            };
 
-    private:
-        using create_func = std::function<std::shared_ptr<Component>()>;
+            name_ids[name] = type_id;
 
-        /**
-         * @brief Create a new component instance by type.
-         * @tparam T Concrete component type, must be registered.
-         * @return shared_ptr to the new Component, or nullptr if type not registered.
-         */
-        template <typename T>
-        std::shared_ptr<Component> instantiate_raw() const
-        {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+            create_column_func create_column = []() -> std::unique_ptr<ComponentColumnBase>
+            { return std::make_unique<ComponentColumn<T>>(); };
 
-            std::type_index id(typeid(T));
+            update_column_func update_column = nullptr;
 
-            std::string type_name{};
-            auto type_name_it = type_names.find(id);
-            if (type_name_it != type_names.end())
+            // &T::update keeps the type Component::* unless T or one of its bases overrides it
+            if constexpr (!std::is_same_v<decltype(&T::update), void (Component::*)(float)>)
             {
-                type_name = type_name_it->second;
+                update_column = [](ComponentColumnBase &column, size_t count, float delta_time)
+                {
+                    T *components = static_cast<ComponentColumn<T> &>(column).data();
+
+                    // Qualified call, resolved at compile time instead of through the vtable
+                    for (size_t row = 0; row < count; row++)
+                    {
+                        if (components[row].is_enabled())
+                            components[row].T::update(delta_time);
+                    }
+                };
+
+                update_types.push_back(type_id);
             }
 
-            if (type_name.empty())
-            {
-                throw std::runtime_error("No matching component found in registry with type provided.");
-            }
+            bool remaps_references = !std::is_same_v<decltype(&T::remap_references), void (Component::*)(const ReferenceRemap &)>;
 
-            auto creator_it = creators.find(type_name);
-            if (creator_it != creators.end())
-            {
-                return creator_it->second();
-            }
+            type_infos.push_back({name, create_column, update_column, remaps_references});
 
-            throw std::runtime_error("No matching component found in registry with name " + type_name + ".");
+            return type_id;
         }
 
         /**
-         * @brief Create a new component instance by type.
-         * @tparam T Concrete component type, must be registered.
-         * @return shared_ptr to the new T, or nullptr if type not registered.
+         * @brief Get the dense type ID of a registered component type.
+         * @tparam T Concrete component type.
+         * @return The type ID, or INVALID_COMPONENT_TYPE if T is not registered.
          */
         template <typename T>
-        std::shared_ptr<T> instantiate_raw_typed() const
+        ComponentTypeID get_type_id() const
         {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+            return component_type_id<T>();
+        }
+
+        /**
+         * @brief Get the dense type ID of a component type by its registered name.
+         * @return The type ID, or INVALID_COMPONENT_TYPE if no type has that name.
+         */
+        ComponentTypeID get_type_id(const std::string &name) const;
 
-            std::shared_ptr<Component> base = instantiate_raw<T>();
+        /**
+         * @brief Get the registered name of a component type ID.
+         */
+        const std::string &get_type_name(ComponentTypeID type_id) const { return type_infos.at(type_id).name; }
 
-            return std::static_pointer_cast<T>(base);
+        size_t get_type_count() const { return type_infos.size(); }
+
+        /**
+         * @brief Types that override Component::update, in registration order.
+         */
+        const std::vector<ComponentTypeID> &get_update_types() const { return update_types; }
+
+        /**
+         * @brief Calls update on the enabled components in the first @p count rows of a column, without virtual dispatch.
+         *
+         * Does nothing if the type does not override Component::update.
+         */
+        void update_column(ComponentTypeID type_id, ComponentColumnBase &column, size_t count, float delta_time) const
+        {
+            if (update_column_func update = type_infos[type_id].update_column)
+                update(column, count, delta_time);
         }
 
         /**
-         * @brief Create a new component instance by registered name.
-         * @param name The registered name of the component type.
-         * @return shared_ptr to the new Component, or nullptr if name not found.
+         * @brief Whether the type overrides Component::remap_references.
          */
-        std::shared_ptr<Component> instantiate_raw(const std::string &name) const;
+        bool remaps_references(ComponentTypeID type_id) const { return type_infos[type_id].remaps_references; }
 
         /**
-         * @brief Get the registered name for a component type T.
-         * @tparam T Concrete component type, must be registered.
-         * @return The registered string name, or empty string if not registered.
+         * @brief Create an empty storage column for components of the given type.
          */
-        template <typename T>
-        std::string get_name() const
+        std::unique_ptr<ComponentColumnBase> create_column(ComponentTypeID type_id) const;
+
+    private:
+        using create_func = std::unique_ptr<Component> (*)();
+        using create_column_func = std::unique_ptr<ComponentColumnBase> (*)();
+        using update_column_func = void (*)(ComponentColumnBase &, size_t, float);
+
+        struct ComponentTypeInfo
         {
-            std::type_index id(typeid(T));
+            std::string name;
+            create_column_func create_column;
 
-            auto it = type_names.find(id);
-            if (it != type_names.end())
-            {
-                return it->second;
-            }
+            // Null when the type does not override Component::update
+            update_column_func update_column;
 
-            return {};
-        }
+            bool remaps_references;
+        };
+
+        /**
+         * @brief Create a new component instance by registered name.
+         * @param name The registered name of the component type.
+         * @return The new Component. Throws if no type has that name.
+         */
+        std::unique_ptr<Component> instantiate_raw(const std::string &name) const;
 
         std::unordered_map<std::string, create_func> creators;
-        std::unordered_map<std::type_index, std::string> type_names;
+
+        std::vector<ComponentTypeInfo> type_infos;
+        std::vector<ComponentTypeID> update_types;
+        std::unordered_map<std::string, ComponentTypeID> name_ids;
     };
 }
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <bitset>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine
+{
+    /// Dense identifier assigned to every component type when it is registered.
+    using ComponentTypeID = uint32_t;
+
+    constexpr ComponentTypeID INVALID_COMPONENT_TYPE = UINT32_MAX;
+
+    /// Upper bound on the number of registered component types, the width of a ComponentSignature.
+    constexpr size_t MAX_COMPONENT_TYPES = 128;
+
+    /// Bit N is set when the owner has a component whose ComponentTypeID is N.
+    using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+
+    /**
+     * @brief Holds the dense type ID of component type T.
+     *
+     * Written once by ComponentRegistry::register_type, so looking up the ID of a type is a
+     * single load instead of a hash lookup on std::type_index and needs no RTTI.
+     *
+     * Every module gets its own copy of this member on Windows, so a shared engine DLL only works
+     * there when components are registered and used from the same module, see engine/CMakeLists.txt.
+     */
+    template <typename T>
+    struct ComponentTypeIndex
+    {
+        static inline ComponentTypeID value = INVALID_COMPONENT_TYPE;
+    };
+
+    /**
+     * @brief Returns the dense type ID of T, or INVALID_COMPONENT_TYPE if T has not been registered.
+     *
+     * Const qualified types share the ID of the unqualified type.
+     */
+    template <typename T>
+    inline ComponentTypeID component_type_id()
+    {
+        return ComponentTypeIndex<std::remove_cv_t<T>>::value;
+    }
+
+    /**
+     * @brief Builds the signature containing every type in Ts.
+     * @return false if any of Ts is not registered, in which case nothing can match it.
+     */
+    template <typename... Ts>
+    inline bool make_component_signature(ComponentSignature &signature)
+    {
+        signature.reset();
+
+        bool registered = true;
+        ((component_type_id<Ts>() == INVALID_COMPONENT_TYPE ? void(registered = false)
+                                                             : void(signature.set(component_type_id<Ts>()))),
+         ...);
+
+        return registered;
+    }
+}
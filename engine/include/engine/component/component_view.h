@@ -0,0 +1,358 @@
+#pragma once
+
+#include "engine/component/archetype.h"
+#include "engine/component/component_column.h"
+#include "engine/component/component_type.h"
+#include "engine/entity/entity_id.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Iterable set of entities that own every component type in Ts.
+     *
+     * A view walks only the archetypes cached as matching its signature, so creating one
+     * per frame is cheap. Dereferencing yields a tuple of the entity ID and typed references:
+     *
+     * @code
+     * for (auto [entity, transform, camera] : stage.view<const Transform3D, Camera3D>())
+     * @endcode
+     *
+     * Every row visited through a non-const type is marked changed at the view's tick, const
+     * types are read only. changed_since and added_since narrow the view to rows whose tick
+     * for one type is newer than a given tick:
+     *
+     * @code
+     * for (auto [entity, body] : stage.view<const RigidBody>().changed_since<const RigidBody>(get_last_run_tick()))
+     * @endcode
+     *
+     * Only rows of active entities whose components are all enabled are visited, include_inactive()
+     * and include_disabled() opt into the others. Inactive rows are cut off at the archetype's active
+     * count, disabled components are skipped row by row.
+     *
+     * Like component pointers, a view and its iterators are invalidated by structural changes.
+     */
+    template <typename... Ts>
+    class View
+    {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+        static constexpr size_t TYPE_COUNT = sizeof...(Ts);
+
+        // Each type can be filtered once on its changed tick and once on its added tick
+        static constexpr size_t MAX_FILTERS = TYPE_COUNT * 2;
+
+        struct TickFilter
+        {
+            ComponentTypeID type = INVALID_COMPONENT_TYPE;
+            uint32_t tick = 0;
+            bool added = false;
+        };
+
+    public:
+        using value_type = std::tuple<EntityID, Ts &...>;
+
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = View::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            Iterator(const View &view, size_t archetype_position)
+                : archetypes(view.archetypes), matches(view.matches), tick(view.tick), inactive(view.inactive),
+                  disabled(view.disabled), filters(view.filters), filter_count(view.filter_count), archetype_position(archetype_position)
+            {
+                load_archetype();
+            }
+
+            value_type operator*() const
+            {
+                for (uint32_t *changed_ticks : stamp_ticks)
+                {
+                    if (changed_ticks)
+                        changed_ticks[row] = tick;
+                }
+
+                return std::apply([this](Ts *...columns)
+                                  { return value_type(entities[row], columns[row]...); },
+                                  columns);
+            }
+
+            Iterator &operator++()
+            {
+                row++;
+                if (!skip_filtered())
+                {
+                    archetype_position++;
+                    load_archetype();
+                }
+
+                return *this;
+            }
+
+            bool operator==(const Iterator &other) const
+            {
+                return archetype_position == other.archetype_position && row == other.row;
+            }
+
+            bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+        private:
+            const std::vector<std::unique_ptr<Archetype>> *archetypes;
+            const std::vector<uint32_t> *matches;
+
+            uint32_t tick;
+            bool inactive;
+            bool disabled;
+            std::array<TickFilter, MAX_FILTERS> filters;
+            size_t filter_count;
+
+            size_t archetype_position;
+            size_t row = 0;
+            size_t count = 0;
+
+            const EntityID *entities = nullptr;
+            std::tuple<Ts *...> columns;
+            std::array<uint32_t *, TYPE_COUNT> stamp_ticks = {};
+            std::array<const uint32_t *, MAX_FILTERS> filter_ticks = {};
+
+            // Skips empty archetypes and caches the column pointers of the next one with a passing row
+            void load_archetype()
+            {
+                row = 0;
+                count = 0;
+
+                while (archetype_position < matches->size())
+                {
+                    Archetype &archetype = *(*archetypes)[(*matches)[archetype_position]];
+                    if (View::row_count(archetype, inactive) > 0)
+                    {
+                        entities = archetype.get_entities().data();
+                        count = View::row_count(archetype, inactive);
+                        columns = std::make_tuple(View::column_data<Ts>(archetype)...);
+                        stamp_ticks = View::stamp_columns(archetype);
+                        filter_ticks = View::filter_columns(archetype, filters, filter_count);
+
+                        if (skip_filtered())
+                            return;
+                    }
+
+                    archetype_position++;
+                    row = 0;
+                    count = 0;
+                }
+            }
+
+            // Advances row to the next row passing every filter, false if the archetype has none left
+            bool skip_filtered()
+            {
+                while (row < count && !View::passes(filters, filter_ticks, filter_count, disabled, columns, row))
+                    row++;
+
+                return row < count;
+            }
+        };
+
+        View(const std::vector<std::unique_ptr<Archetype>> *archetypes, const std::vector<uint32_t> *matches, uint32_t tick)
+            : archetypes(archetypes), matches(matches), tick(tick) {}
+
+        Iterator begin() const { return Iterator(*this, 0); }
+        Iterator end() const { return Iterator(*this, matches->size()); }
+
+        /**
+         * @brief Returns a copy of this view limited to rows whose T was handed out mutably after @p tick.
+         */
+        template <typename T>
+        View changed_since(uint32_t tick) const
+        {
+            return with_filter<T>(tick, false);
+        }
+
+        /**
+         * @brief Returns a copy of this view limited to rows whose T was added after @p tick.
+         */
+        template <typename T>
+        View added_since(uint32_t tick) const
+        {
+            return with_filter<T>(tick, true);
+        }
+
+        /**
+         * @brief Returns a copy of this view that also visits rows of inactive entities.
+         */
+        View include_inactive() const
+        {
+            View all = *this;
+            all.inactive = true;
+            return all;
+        }
+
+        /**
+         * @brief Returns a copy of this view that also visits rows where one of Ts is disabled.
+         */
+        View include_disabled() const
+        {
+            View all = *this;
+            all.disabled = true;
+            return all;
+        }
+
+        /**
+         * @brief Calls @p func(EntityID, Ts &...) for every matching entity.
+         */
+        template <typename Func>
+        void each(Func &&func) const
+        {
+            for (uint32_t archetype_index : *matches)
+            {
+                Archetype &archetype = *(*archetypes)[archetype_index];
+
+                const EntityID *entities = archetype.get_entities().data();
+                size_t count = row_count(archetype, inactive);
+
+                std::tuple<Ts *...> columns(column_data<Ts>(archetype)...);
+                std::array<uint32_t *, TYPE_COUNT> stamp_ticks = stamp_columns(archetype);
+                std::array<const uint32_t *, MAX_FILTERS> filter_ticks = filter_columns(archetype, filters, filter_count);
+
+                std::apply([&](Ts *...data)
+                           {
+                               for (size_t row = 0; row < count; row++)
+                               {
+                                   if (!passes(filters, filter_ticks, filter_count, disabled, columns, row))
+                                       continue;
+
+                                   for (uint32_t *changed_ticks : stamp_ticks)
+                                   {
+                                       if (changed_ticks)
+                                           changed_ticks[row] = tick;
+                                   }
+
+                                   func(entities[row], data[row]...);
+                               } },
+                           columns);
+            }
+        }
+
+        size_t size() const
+        {
+            size_t total = 0;
+            for (uint32_t archetype_index : *matches)
+            {
+                Archetype &archetype = *(*archetypes)[archetype_index];
+
+                size_t count = row_count(archetype, inactive);
+
+                if (filter_count == 0 && disabled)
+                {
+                    total += count;
+                    continue;
+                }
+
+                std::tuple<Ts *...> columns(column_data<Ts>(archetype)...);
+                std::array<const uint32_t *, MAX_FILTERS> filter_ticks = filter_columns(archetype, filters, filter_count);
+                for (size_t row = 0; row < count; row++)
+                    total += passes(filters, filter_ticks, filter_count, disabled, columns, row) ? 1 : 0;
+            }
+
+            return total;
+        }
+
+        bool empty() const { return begin() == end(); }
+
+    private:
+        const std::vector<std::unique_ptr<Archetype>> *archetypes;
+        const std::vector<uint32_t> *matches;
+
+        uint32_t tick;
+        bool inactive = false;
+        bool disabled = false;
+        std::array<TickFilter, MAX_FILTERS> filters = {};
+        size_t filter_count = 0;
+
+        static size_t row_count(const Archetype &archetype, bool inactive)
+        {
+            return inactive ? archetype.size() : archetype.get_active_count();
+        }
+
+        template <typename T>
+        View with_filter(uint32_t since, bool added) const
+        {
+            static_assert((std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>> || ...),
+                          "Filtered type must be one of the view's types");
+
+            if (filter_count == MAX_FILTERS)
+                throw std::runtime_error("Too many tick filters on one view");
+
+            View filtered = *this;
+            filtered.filters[filtered.filter_count++] = {component_type_id<T>(), since, added};
+            return filtered;
+        }
+
+        template <typename T>
+        static T *column_data(Archetype &archetype)
+        {
+            using U = std::remove_const_t<T>;
+
+            int column_index = archetype.get_column_index(component_type_id<T>());
+            return static_cast<ComponentColumn<U> &>(archetype.get_column(column_index)).data();
+        }
+
+        // Changed tick arrays of the non-const types, null for read only ones
+        static std::array<uint32_t *, TYPE_COUNT> stamp_columns(Archetype &archetype)
+        {
+            return {stamp_column<Ts>(archetype)...};
+        }
+
+        template <typename T>
+        static uint32_t *stamp_column(Archetype &archetype)
+        {
+            if constexpr (std::is_const_v<T>)
+                return nullptr;
+            else
+                return archetype.get_column(archetype.get_column_index(component_type_id<T>())).get_changed_ticks();
+        }
+
+        static std::array<const uint32_t *, MAX_FILTERS> filter_columns(Archetype &archetype, const std::array<TickFilter, MAX_FILTERS> &filters,
+                                                                         size_t filter_count)
+        {
+            std::array<const uint32_t *, MAX_FILTERS> ticks = {};
+            for (size_t i = 0; i < filter_count; i++)
+            {
+                const ComponentColumnBase &column = archetype.get_column(archetype.get_column_index(filters[i].type));
+                ticks[i] = filters[i].added ? column.get_added_ticks() : column.get_changed_ticks();
+            }
+
+            return ticks;
+        }
+
+        // True if the row passes every tick filter and, unless disabled rows are included, all of Ts are enabled
+        static bool passes(const std::array<TickFilter, MAX_FILTERS> &filters, const std::array<const uint32_t *, MAX_FILTERS> &ticks,
+                           size_t filter_count, bool disabled, const std::tuple<Ts *...> &columns, size_t row)
+        {
+            for (size_t i = 0; i < filter_count; i++)
+            {
+                // Signed distance so the comparison stays correct after the tick counter wraps
+                if (static_cast<int32_t>(ticks[i][row] - filters[i].tick) <= 0)
+                    return false;
+            }
+
+            if (disabled)
+                return true;
+
+            return std::apply([row](Ts *...data)
+                              { return (data[row].is_enabled() && ...); },
+                              columns);
+        }
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "engine/component/component_handle.h"
+#include "engine/component/component_id.h"
+#include "engine/entity/entity_id.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace Engine
+{
+    /**
+     * @brief Maps IDs of a prefab's source entities and components to those of one instance.
+     *
+     * IDs that were not part of the baked subtree map to themselves, so references to
+     * entities outside the prefab are kept as they are.
+     */
+    class ReferenceRemap
+    {
+    public:
+        ReferenceRemap(const std::unordered_map<EntityID, uint32_t> &entity_lookup, const EntityID *entities,
+                       const std::unordered_map<ComponentID, uint32_t> &component_lookup, const ComponentID *components)
+            : entity_lookup(entity_lookup), entities(entities), component_lookup(component_lookup), components(components) {}
+
+        EntityID map(const EntityID &id) const
+        {
+            auto it = entity_lookup.find(id);
+            return it != entity_lookup.end() ? entities[it->second] : id;
+        }
+
+        ComponentID map(const ComponentID &id) const
+        {
+            auto it = component_lookup.find(id);
+            return it != component_lookup.end() ? components[it->second] : id;
+        }
+
+        template <typename T>
+        ComponentHandle<T> map(const ComponentHandle<T> &handle) const
+        {
+            return {map(handle.id), handle.type_id};
+        }
+
+    private:
+        const std::unordered_map<EntityID, uint32_t> &entity_lookup;
+        const EntityID *entities;
+
+        const std::unordered_map<ComponentID, uint32_t> &component_lookup;
+        const ComponentID *components;
+    };
+}
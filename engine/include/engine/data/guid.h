@@ -24,9 +24,9 @@ namespace Engine
         {
             GUID guid;
 
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<uint32_t> dis(0, UINT32_MAX);
+            // Per thread, so GUIDs can be generated from jobs
+            thread_local std::mt19937 gen(std::random_device{}());
+            thread_local std::uniform_int_distribution<uint32_t> dis(0, UINT32_MAX);
 
             for (size_t i = 0; i < SIZE; i += 4)
             {
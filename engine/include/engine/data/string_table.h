@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Engine
+{
+    using StringID = uint32_t;
+
+    /**
+     * @brief Interns strings into dense integer IDs.
+     *
+     * Each distinct string is stored once and keeps its ID for the lifetime of the table, so
+     * IDs can be compared and used as array indices instead of hashing or comparing text.
+     * Strings are never removed; tables are meant to live as long as what they name.
+     */
+    class StringTable
+    {
+    public:
+        static constexpr StringID INVALID_STRING = UINT32_MAX;
+
+        StringTable() = default;
+
+        StringTable(const StringTable &) = delete;
+        StringTable &operator=(const StringTable &) = delete;
+
+        /**
+         * @brief Returns the ID of @p text, adding it to the table if it is not there yet.
+         */
+        StringID intern(std::string_view text);
+
+        /**
+         * @brief Returns the ID of @p text without adding it, or INVALID_STRING.
+         */
+        StringID find(std::string_view text) const;
+
+        /**
+         * @brief Returns the interned string. The reference stays valid for the lifetime of the table.
+         */
+        const std::string &get(StringID id) const { return strings[id]; }
+
+        size_t size() const { return strings.size(); }
+
+    private:
+        // Deque keeps element addresses stable, so the lookup keys can view into it
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, StringID> ids;
+    };
+}
@@ -1,48 +1,112 @@
 #pragma once
 
 #include "engine/entity/entity_id.h"
+#include "engine/component/component_handle.h"
+#include "engine/data/string_table.h"
 #include "engine/serialization/serialization_context.h"
 #include "engine/serialization/serializable.h"
 
 #include <string>
+#include <string_view>
 #include <memory>
-#include <typeindex>
 #include <vector>
 
 namespace Engine
 {
     class Component;
+    class ComponentManager;
     class EntityManager;
 
     class Entity : public Serialization::Serializable
     {
         friend class EntityManager;
+        friend class EntityHierarchy;
 
     public:
-        explicit Entity(std::string name);
+        explicit Entity(StringID name_id);
         ~Entity() = default;
 
+        Entity(Entity &&) = default;
+        Entity &operator=(Entity &&) = default;
+
+        Entity(const Entity &) = default;
+        Entity &operator=(const Entity &) = default;
+
         // Accessors
         EntityID get_id() const;
         Entity *get_parent() const;
-        std::string get_name() const;
         std::vector<Entity *> get_children() const;
 
+        EntityID get_parent_id() const { return parent_id; }
+        const std::vector<EntityID> &get_child_ids() const { return children_ids; }
+
+        /**
+         * @brief Returns the name, interned in the EntityManager's name table.
+         */
+        const std::string &get_name() const;
+        StringID get_name_id() const { return name_id; }
+
+        /**
+         * @brief Renames the entity through its EntityManager, keeping the name index current.
+         */
+        void set_name(std::string_view name);
+
+        /**
+         * @brief Own enabled flag, regardless of the parents.
+         */
+        bool is_enabled() const { return enabled; }
+
+        /**
+         * @brief Whether the entity and every ancestor are enabled. Only active entities are set up, updated and visited by views.
+         */
+        bool is_active() const { return active; }
+
+        /**
+         * @brief Enables or disables the entity and with it the whole subtree below it.
+         */
+        void set_enabled(bool enabled);
+
         // Components
+        /**
+         * @brief Adds a component of type T, moving the entity into the archetype that stores T.
+         * @return Pointer to the component, valid until the next structural change.
+         */
         template <typename T>
         T *add_component();
 
+        /**
+         * @brief Returns the entity's T for writing and marks it changed at the current tick.
+         */
+        template <typename T>
+        T *get_component();
+
+        /**
+         * @brief Returns the entity's T without marking it changed.
+         */
         template <typename T>
-        T *get_component() const;
+        const T *get_component() const;
 
         template <typename T>
         bool has_component() const;
 
+        /**
+         * @brief Returns a handle to the entity's T that stays valid across structural changes.
+         */
         template <typename T>
-        std::vector<T *> get_all_components_of_type() const;
+        ComponentHandle<T> get_component_handle() const;
+
+        /**
+         * @brief Returns the components whose exact type is T. Entities hold at most one component per type.
+         */
+        template <typename T>
+        std::vector<T *> get_all_components_of_type();
 
         // Related to other entities
-        void set_parent(const EntityID &parent);
+        /**
+         * @brief Re-parents the entity through its EntityManager. Pass EntityID::Invalid to make it a root.
+         * @return false if the parent does not exist or would create a cycle.
+         */
+        bool set_parent(const EntityID &parent);
 
         // Serialization
         void serialize(Serialization::SerializationContext &ctx) const override;
@@ -54,14 +118,18 @@ namespace Engine
 
     private:
         // Relation to other entities
-        EntityManager *entity_manager;
-        EntityID parent_id;
+        EntityManager *entity_manager = nullptr;
+        EntityID parent_id = EntityID::Invalid;
         std::vector<EntityID> children_ids;
 
         // Self properties
-        EntityID id;
-        std::string name;
-        std::vector<std::shared_ptr<Component>> components;
+        EntityID id = EntityID::Invalid;
+        StringID name_id = StringTable::INVALID_STRING;
+
+        bool enabled = true;
+        bool active = true;
+
+        ComponentManager *get_component_manager() const;
 
         void set_manager(EntityManager *entity_manager) { this->entity_manager = entity_manager; }
     };
@@ -11,18 +11,11 @@ namespace Engine
 
         try
         {
-            auto &stage_manager = StageManager::get_instance();
-            Stage *stage = stage_manager.get_current_stage();
-            if (stage == nullptr)
-                throw std::runtime_error("Current scene is null");
+            ComponentManager *component_manager = get_component_manager();
+            if (component_manager == nullptr)
+                throw std::runtime_error("Entity does not belong to a stage");
 
-            ComponentManager &component_manager = stage->get_component_manager();
-
-            std::shared_ptr<Component> component_ptr = component_manager.create_component<T>(id);
-            Component *ptr = component_ptr.get();
-
-            components.push_back(component_ptr);
-            return static_cast<T *>(ptr);
+            return component_manager->create_component<T>(id);
         }
         catch (const std::exception &e)
         {
@@ -35,36 +28,59 @@ namespace Engine
     {
         static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
 
-        return get_component<T>() != nullptr;
+        ComponentManager *component_manager = get_component_manager();
+        if (!component_manager)
+            return false;
+
+        return component_manager->has_component<T>(id);
     }
 
     template <typename T>
-    std::vector<T *> Entity::get_all_components_of_type() const
+    ComponentHandle<T> Entity::get_component_handle() const
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
+
+        ComponentManager *component_manager = get_component_manager();
+        if (!component_manager)
+            return {};
+
+        return component_manager->get_handle<T>(id);
+    }
+
+    template <typename T>
+    std::vector<T *> Entity::get_all_components_of_type()
     {
         static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
 
         std::vector<T *> found_components;
 
-        for (const auto &comp : components)
-        {
-            if (auto ptr = dynamic_cast<T *>(comp.get()))
-                found_components.push_back(ptr);
-        }
+        if (T *component = get_component<T>())
+            found_components.push_back(component);
 
         return found_components;
     }
 
     template <typename T>
-    T *Entity::get_component() const
+    T *Entity::get_component()
     {
         static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
 
-        for (const auto &comp : components)
-        {
-            if (auto ptr = dynamic_cast<T *>(comp.get()))
-                return ptr;
-        }
+        ComponentManager *component_manager = get_component_manager();
+        if (!component_manager)
+            return nullptr;
+
+        return component_manager->get_component<T>(id);
+    }
+
+    template <typename T>
+    const T *Entity::get_component() const
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
+
+        const ComponentManager *component_manager = get_component_manager();
+        if (!component_manager)
+            return nullptr;
 
-        return nullptr;
+        return component_manager->read_component<T>(id);
     }
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "engine/entity/entity_id.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+    class EntityManager;
+
+    /**
+     * @brief Flattened parent/child tree of a stage, stored in breadth-first order.
+     *
+     * Roots come first, followed by every depth level in turn, so a parent always precedes
+     * its children. get_parent_indices() runs parallel to get_order() and holds the position
+     * of each node's parent in that same array, which turns a full-tree walk into one forward
+     * pass:
+     *
+     * @code
+     * for (size_t i = 0; i < order.size(); i++)
+     *     world[i] = parents[i] == EntityHierarchy::NO_PARENT ? local[i] : world[parents[i]] * local[i];
+     * @endcode
+     *
+     * The arrays are rebuilt by EntityManager on demand after a structural change, so they
+     * are invalidated by set_parent, create and destroy calls.
+     */
+    class EntityHierarchy
+    {
+    public:
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        /**
+         * @brief Every living entity, roots first and then level by level.
+         */
+        const std::vector<EntityID> &get_order() const { return order; }
+
+        /**
+         * @brief Position of each node's parent in get_order(), or NO_PARENT for roots.
+         */
+        const std::vector<uint32_t> &get_parent_indices() const { return parent_indices; }
+
+        /**
+         * @brief Distance of each node from its root. Non-decreasing along get_order().
+         */
+        const std::vector<uint32_t> &get_depths() const { return depths; }
+
+        /**
+         * @brief Position of @p id in get_order(), or NO_PARENT if the entity is not part of the hierarchy.
+         */
+        uint32_t get_position(const EntityID &id) const;
+
+        size_t size() const { return order.size(); }
+
+    private:
+        friend class EntityManager;
+
+        std::vector<EntityID> order;
+        std::vector<uint32_t> parent_indices;
+        std::vector<uint32_t> depths;
+
+        // Indexed by EntityID::index
+        std::vector<uint32_t> positions;
+
+        void rebuild(const EntityManager &manager);
+    };
+}
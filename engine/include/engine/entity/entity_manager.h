@@ -1,28 +1,181 @@
 #pragma once
 
 #include "engine/entity/entity_id.h"
+#include "engine/entity/entity_hierarchy.h"
+#include "engine/component/component_type.h"
+#include "engine/data/string_table.h"
 #include "engine/serialization/serializable.h"
 #include "engine/base/singleton.h"
 
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace Engine
 {
     class Entity;
+    class Prefab;
     class Stage;
 
+    /**
+     * @brief Owns every entity of a stage using a generational slot map.
+     *
+     * Entities are stored by value in a dense array so that setup() and update() walk
+     * contiguous memory. EntityID::index addresses a sparse slot table which maps to the
+     * dense position, and EntityID::generation is compared against the slot's current
+     * generation to reject stale IDs in O(1).
+     *
+     * Destroying an entity swaps the last dense entity into the freed position, so raw
+     * Entity pointers are only valid until the next create or destroy call. Store the
+     * EntityID when a reference has to outlive that.
+     *
+     * Parent/child links live on each Entity; get_hierarchy() exposes the same tree flattened
+     * into breadth-first order for linear walks.
+     *
+     * The dense array is partitioned: active entities come first, so setup() and update() stop
+     * after get_active_count() entities and dormant ones cost nothing per frame.
+     *
+     * Names are interned into a per-stage StringTable and indexed by name ID, so find_entities()
+     * and find_entity_by_path() cost a table lookup instead of a scan over every entity.
+     */
     class EntityManager : public Serialization::Serializable, public Singleton<EntityManager>
     {
     public:
         EntityManager(Stage *owner_stage_ptr);
+        ~EntityManager();
 
-        Entity *create_entity(std::string name);
+        /**
+         * @brief Creates a new entity, reusing a free slot index when possible.
+         *
+         * @param name Display name of the entity.
+         * @return Pointer to the new entity. Invalidated by the next create or destroy call.
+         */
+        Entity *create_entity(std::string_view name);
+
+        /**
+         * @brief Creates @p count entities that each own a default constructed component of every type in @p components.
+         *
+         * Reserves IDs and storage once and constructs the components column by column. Fires
+         * ComponentManager::components_created_batch once instead of an event per component.
+         *
+         * @param out_ids Receives the new IDs, appended in creation order.
+         * @param name Display name given to every new entity.
+         */
+        void create_entities(size_t count, const ComponentSignature &components, std::vector<EntityID> &out_ids,
+                             std::string_view name = "Entity");
+
+        template <typename... Ts>
+        void create_entities(size_t count, std::vector<EntityID> &out_ids, std::string_view name = "Entity")
+        {
+            ComponentSignature components;
+            if (!make_component_signature<Ts...>(components))
+                throw std::runtime_error("Component type is not registered in ComponentRegistry!");
+
+            create_entities(count, components, out_ids, name);
+        }
+
+        /**
+         * @brief Spawns @p count copies of @p prefab, each a new root with the prefab's hierarchy and components.
+         *
+         * Entities are allocated in one pass and linked directly, components are cloned by
+         * ComponentManager::instantiate_components. Names and enabled flags come from the prefab.
+         *
+         * @param out_roots Receives the root of every instance, appended in creation order.
+         */
+        void instantiate(const Prefab &prefab, size_t count, std::vector<EntityID> &out_roots);
 
+        /**
+         * @brief Destroys the entity together with all of its descendants.
+         */
         void destroy_entity(const EntityID &id);
         void destroy_entity(const Entity &entity);
 
+        /**
+         * @brief Moves @p child under @p parent, or makes it a root when @p parent is EntityID::Invalid.
+         *
+         * @return false if either entity does not exist or @p parent is @p child or one of its descendants.
+         */
+        bool set_parent(const EntityID &child, const EntityID &parent);
+
+        /**
+         * @brief Appends every descendant of @p root to @p out, in breadth-first order.
+         *
+         * Follows the children links of the subtree only, so the cost does not depend on the
+         * size of the stage and the flattened hierarchy is not rebuilt.
+         */
+        void collect_descendants(const EntityID &root, std::vector<EntityID> &out) const;
+
+        /**
+         * @brief Sets the entity's own enabled flag and updates the effective state of its subtree.
+         *
+         * Entities whose effective state changes move between the active and inactive ranges,
+         * here and in their archetypes, which invalidates Entity pointers.
+         */
+        void set_enabled(const EntityID &id, bool enabled);
+
+        /**
+         * @brief Recomputes the effective state of every entity, e.g. after loading.
+         */
+        void refresh_active_states();
+
+        /**
+         * @brief Changes the entity's name and moves it to the matching name index bucket.
+         */
+        void rename_entity(const EntityID &id, std::string_view name);
+
+        /**
+         * @brief Returns every living entity named @p name, in no particular order.
+         */
+        const std::vector<EntityID> &find_entities(std::string_view name) const;
+
+        /**
+         * @brief Returns one entity named @p name, or nullptr if there is none.
+         */
+        Entity *find_entity(std::string_view name) const;
+
+        /**
+         * @brief Resolves a '/' separated chain of names starting at a root, e.g. "Level/Spawner/Point03".
+         *
+         * Candidates for the last segment come from the name index and are checked upwards
+         * against their ancestors, so the cost does not depend on the size of the stage.
+         * When several entities match the path, any one of them is returned.
+         *
+         * @return The matching entity, or nullptr if there is none or the path has an empty segment.
+         */
+        Entity *find_entity_by_path(std::string_view path) const;
+
+        /**
+         * @brief Builds the path of the entity that find_entity_by_path() resolves, or an empty string for a stale ID.
+         */
+        std::string get_path(const EntityID &id) const;
+
+        StringTable &get_name_table() { return name_table; }
+        const StringTable &get_name_table() const { return name_table; }
+
+        /**
+         * @brief Returns the breadth-first hierarchy, rebuilding it first if the tree changed since the last call.
+         */
+        const EntityHierarchy &get_hierarchy();
+
+        /**
+         * @brief Counter bumped whenever a parent link is set, including by instantiate. Creating roots or destroying subtrees leaves it untouched.
+         */
+        uint64_t get_hierarchy_version() const { return hierarchy_version; }
+
+        /**
+         * @brief Records an entity whose Transform3D became dirty, called by Transform3D::mark_dirty.
+         */
+        void record_transform_change(const EntityID &id);
+
+        /**
+         * @brief Moves the entities recorded since the last call to the end of @p out.
+         */
+        void take_transform_changes(std::vector<EntityID> &out);
+
         /**
          * @brief Checks if entity with id exists in given managers entity list.
          *
@@ -35,15 +188,52 @@ namespace Engine
         /**
          * @brief Retrieves a pointer to the entity associated with the given EntityID.
          *
-         * Searches the internal entity map for the provided ID. If an entity with that ID exists,
-         * a raw pointer to the entity is returned. If not found, returns nullptr.
+         * Validates the index and generation against the slot table. If the ID refers to a
+         * living entity, a raw pointer into the dense entity array is returned. If not, returns nullptr.
          *
          * @param id The unique identifier of the entity to look up.
          * @return Pointer to the Entity if found, or nullptr if no entity with the given ID exists.
          */
         Entity *get_entity_by_id(const EntityID &id) const;
 
-        std::unordered_map<EntityID, std::unique_ptr<Entity>> *get_entity_list() { return &entity_list; }
+        /**
+         * @brief Dense array of all living entities, active ones first and otherwise in no particular order.
+         */
+        std::vector<Entity> &get_entities() { return entities; }
+        const std::vector<Entity> &get_entities() const { return entities; }
+
+        size_t get_entity_count() const;
+        size_t get_active_count() const { return active_count; }
+
+        Stage *get_stage() const { return stage; }
+
+        /// Copy of the entity records and ID tables, filled by capture and applied by restore
+        struct Snapshot
+        {
+            std::vector<Entity> entities;
+            size_t active_count = 0;
+
+            std::vector<uint32_t> slots;
+            std::vector<uint32_t> generations;
+            std::vector<uint32_t> free_indices;
+
+            std::vector<std::vector<EntityID>> name_index;
+
+            size_t get_byte_size() const;
+        };
+
+        /**
+         * @brief Copies every entity and the ID tables into @p snapshot, reusing its allocations from earlier captures.
+         */
+        void capture(Snapshot &snapshot) const;
+
+        /**
+         * @brief Puts every entity back as it was when @p snapshot was captured. Invalidates Entity pointers.
+         *
+         * Names stay interned, so name IDs in the snapshot keep resolving. The hierarchy counts as
+         * relinked afterwards.
+         */
+        void restore(const Snapshot &snapshot);
 
         void setup();
         void update(const float delta_time);
@@ -53,11 +243,42 @@ namespace Engine
         void deserialize(Serialization::SerializationContext &ctx) override;
 
     private:
-        std::unordered_map<EntityID, std::unique_ptr<Entity>> entity_list;
+        static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+        // Dense entity records, iterated linearly
+        std::vector<Entity> entities;
+        size_t active_count = 0;
 
+        // Sparse tables indexed by EntityID::index
+        std::vector<uint32_t> slots;
         std::vector<uint32_t> generations;
         std::vector<uint32_t> free_indices;
 
+        EntityHierarchy hierarchy;
+        bool hierarchy_dirty = true;
+        uint64_t hierarchy_version = 0;
+
+        // Transforms can be changed from parallel jobs, so recording locks
+        std::mutex transform_changes_mutex;
+        std::vector<EntityID> transform_changes;
+
+        // Entity IDs per name, indexed by StringID
+        StringTable name_table;
+        std::vector<std::vector<EntityID>> name_index;
+
         Stage *stage = nullptr;
+
+        uint32_t allocate_index();
+        void release_entity(const EntityID &id);
+
+        void index_name(const EntityID &id, StringID name_id);
+        void unindex_name(const EntityID &id, StringID name_id);
+
+        void swap_entities(uint32_t a, uint32_t b);
+        // IDs are taken by value since both reorder the dense array a reference could point into
+        void set_active(EntityID id, bool active);
+
+        // Applies the effective state below a changed entity, one pass over its descendants
+        void propagate_active(EntityID root);
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine/component/component_id.h"
+#include "engine/entity/entity_id.h"
+#include "engine/math/matrix4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct FramePacket;
+
+    /// Callback drawing the scene into a camera's viewport, runs on the render thread in pipelined mode
+    using SceneRenderCallback = std::function<void(const Math::Matrix4 &view, const Math::Matrix4 &projection, const FramePacket &packet)>;
+
+    /// Everything the renderer needs from one camera, copied out of its Camera3D
+    struct CameraPacket
+    {
+        /// Identifies the camera's render target between frames
+        ComponentID camera = ComponentID::Invalid;
+
+        Math::Matrix4 view;
+        Math::Matrix4 projection;
+
+        int width = 0;
+        int height = 0;
+
+        SceneRenderCallback on_render_scene;
+    };
+
+    /// A drawable object and the world matrix it is drawn with
+    struct ObjectPacket
+    {
+        EntityID entity;
+        Math::Matrix4 world;
+    };
+
+    /**
+     * @brief Render data extracted from a stage at the end of its update.
+     *
+     * The renderer only reads the packet, never the stage, so the next simulation step can
+     * run while the packet is drawn. Packets are reused frame to frame, clear() keeps the
+     * capacity of their arrays.
+     */
+    struct FramePacket
+    {
+        static constexpr size_t NO_CAMERA = SIZE_MAX;
+
+        uint64_t frame = 0;
+        float time_passed = 0.0f;
+
+        std::vector<CameraPacket> cameras;
+        std::vector<ObjectPacket> objects;
+
+        /// Index into cameras of the camera presented to the window
+        size_t primary_camera = NO_CAMERA;
+
+        void clear()
+        {
+            cameras.clear();
+            objects.clear();
+            primary_camera = NO_CAMERA;
+        }
+    };
+}
@@ -3,11 +3,25 @@
 #include "engine/stage/stage_manager.h"
 #include "engine/base/singleton.h"
 #include "engine/platform/window.h"
+#include "engine/graphics/frame_packet.h"
+#include "engine/graphics/viewport.h"
 
 #include "engine/component/3d/camera_3d.h"
 
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 namespace Engine::Graphics
 {
+    /**
+     * @brief Extracts render data from the current stage and draws it.
+     *
+     * extract() runs on the simulation thread and only reads the stage. render_packet() only
+     * reads the packet, draws it and presents it to the window, so with pipelined rendering it
+     * runs on the render thread, which must own the GL context. The render targets are only
+     * touched by that thread.
+     */
     class RenderManager : public Singleton<RenderManager>
     {
     public:
@@ -15,19 +29,63 @@ namespace Engine::Graphics
         ~RenderManager();
 
         void init();
+
+        /**
+         * @brief Extracts and renders the current stage on the calling thread.
+         */
         void render();
 
-        void on_component_created(std::weak_ptr<Component> component_ptr);
-        void on_component_destroyed(std::weak_ptr<Component> component_ptr);
-        void on_component_destroyed();
+        /**
+         * @brief Fills @p packet with the cameras and object transforms of the current stage.
+         */
+        void extract(FramePacket &packet);
 
-        void present_to_window(Engine::Platform::Window *window);
+        /**
+         * @brief Renders every camera of @p packet into its viewport, then presents the primary
+         *        camera to the window set with set_present_window().
+         */
+        void render_packet(const FramePacket &packet);
+
+        /**
+         * @brief Sets the window the primary camera is presented to, nullptr to present nothing.
+         *        Safe to call from any thread, takes effect with the next render_packet().
+         */
+        void set_present_window(Engine::Platform::Window *window) { present_window.store(window, std::memory_order_release); }
+
+        /**
+         * @brief Selects the camera presented to the window. An invalid handle, or a camera
+         *        that no longer exists, falls back to the first camera of the stage.
+         */
+        void set_primary_camera(ComponentHandle<Camera3D> camera) { primary_camera = camera; }
+
+        /**
+         * @brief Viewport a camera was last rendered into, or nullptr.
+         *
+         * Render thread only: the viewports are created, resized and released by render_packet(),
+         * so with pipelined rendering calling this from another thread races with it.
+         */
+        Viewport *get_viewport(const ComponentID &camera) const;
 
     private:
-        size_t on_component_created_token;
-        size_t on_component_destroyed_token;
+        /// Viewport of a camera and the last frame it was rendered in
+        struct RenderTarget
+        {
+            std::unique_ptr<Viewport> viewport;
+            uint64_t frame = 0;
+        };
 
         StageManager &stage_manager;
-        std::vector<std::weak_ptr<Camera3D>> camera_components;
+        ComponentHandle<Camera3D> primary_camera;
+        std::atomic<Engine::Platform::Window *> present_window{nullptr};
+
+        uint64_t frame_counter = 0;
+        FramePacket immediate_packet;
+
+        // Render thread state
+        std::unordered_map<ComponentID, RenderTarget> render_targets;
+        ComponentID presented_camera = ComponentID::Invalid;
+
+        Viewport *ensure_viewport(const CameraPacket &camera, uint64_t frame);
+        void present_to_window(Engine::Platform::Window *window);
     };
-}
\ No newline at end of file
+}
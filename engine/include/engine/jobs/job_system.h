@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Tracks a group of submitted jobs so a caller can wait for all of them.
+     *
+     * The first exception thrown by a job of the group is kept and rethrown by JobSystem::wait.
+     */
+    class JobCounter
+    {
+        friend class JobSystem;
+
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        bool is_done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        std::atomic<size_t> pending{0};
+
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Pool of worker threads that run short jobs.
+     *
+     * Each worker owns a deque. Jobs submitted from a worker go to its own deque and are
+     * taken newest first, idle workers steal the oldest jobs from other deques. Jobs
+     * submitted from other threads are spread over the deques round robin.
+     *
+     * Threads that wait on a JobCounter run queued jobs until the counter reaches zero, so
+     * jobs may wait on jobs they submit, and a system with no workers still makes progress.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * @param worker_count Number of worker threads. The thread calling wait() helps out,
+         *                     so zero is valid and runs every job on the waiting thread.
+         */
+        explicit JobSystem(size_t worker_count);
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /**
+         * @brief Default worker count, one per hardware thread besides the calling one.
+         */
+        static size_t get_default_worker_count();
+
+        size_t get_worker_count() const { return workers.size(); }
+
+        /**
+         * @brief Queues @p job. If @p counter is set, it stays pending until the job has run.
+         */
+        void submit(std::function<void()> job, JobCounter *counter = nullptr);
+
+        /**
+         * @brief Runs queued jobs on the calling thread until @p counter has no pending jobs.
+         *
+         * Rethrows the first exception thrown by a job of the counter.
+         */
+        void wait(JobCounter &counter);
+
+        /**
+         * @brief Calls @p func(begin, end) over [0, count) split into chunks of at most @p grain_size
+         *        and returns once every chunk has run.
+         *
+         * @param grain_size Chunk size, zero picks one that gives every thread a few chunks.
+         */
+        template <typename Func>
+        void parallel_for(size_t count, size_t grain_size, Func &&func)
+        {
+            if (count == 0)
+                return;
+
+            if (grain_size == 0)
+                grain_size = std::max<size_t>(1, count / ((workers.size() + 1) * 4));
+
+            if (count <= grain_size)
+            {
+                func(size_t(0), count);
+                return;
+            }
+
+            JobCounter counter;
+            for (size_t begin = grain_size; begin < count; begin += grain_size)
+            {
+                size_t end = std::min(begin + grain_size, count);
+                submit([&func, begin, end]()
+                       { func(begin, end); },
+                       &counter);
+            }
+
+            // The first chunk runs here while the workers pick up the rest
+            try
+            {
+                func(size_t(0), grain_size);
+            }
+            catch (...)
+            {
+                record_error(counter, std::current_exception());
+            }
+
+            wait(counter);
+        }
+
+    private:
+        struct Job
+        {
+            std::function<void()> function;
+            JobCounter *counter = nullptr;
+        };
+
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+        std::atomic<size_t> next_queue{0};
+        std::atomic<size_t> queued_jobs{0};
+        std::atomic<bool> running{true};
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake_condition;
+
+        void worker_loop(size_t worker_index);
+
+        bool try_pop(size_t queue_index, Job &job);
+        bool try_steal(size_t thief_index, Job &job);
+        bool try_get_job(Job &job);
+
+        void execute(Job &job);
+        static void record_error(JobCounter &counter, std::exception_ptr error);
+    };
+}
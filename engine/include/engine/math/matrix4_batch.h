@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include "matrix4.h"
+
+namespace Engine::Math
+{
+    /**
+     * @brief Structure-of-arrays view over N translation / rotation / scale triples.
+     *
+     * Every pointer addresses N consecutive floats. Rotations are expected to be normalized.
+     */
+    struct TRSBatch
+    {
+        const float *position_x;
+        const float *position_y;
+        const float *position_z;
+
+        const float *rotation_x;
+        const float *rotation_y;
+        const float *rotation_z;
+        const float *rotation_w;
+
+        const float *scale_x;
+        const float *scale_y;
+        const float *scale_z;
+    };
+
+    /**
+     * @brief Writes T * R * S for each of the @p count triples in @p batch to @p out.
+     *
+     * Processes 8 transforms per iteration when the engine is built with AVX
+     * (ENGINE_ENABLE_AVX), 4 with SSE2, and finishes any remainder with the scalar kernel.
+     * Results match Matrix4::translate(p) * Matrix4::rotate(q) * Matrix4::scale(s).
+     */
+    void compose_trs(const TRSBatch &batch, size_t count, Matrix4 *out);
+
+    /**
+     * @brief Portable reference implementation of compose_trs.
+     */
+    void compose_trs_scalar(const TRSBatch &batch, size_t count, Matrix4 *out);
+}
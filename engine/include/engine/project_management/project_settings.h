@@ -17,6 +17,15 @@ namespace Engine
         std::string project_definition_version;
         std::string last_open_stage;
 
+        /// Worker threads for the job system, -1 uses one per hardware thread besides the main thread
+        int worker_thread_count = -1;
+
+        /// Frames per second EngineInstance paces its main loop to, 0 or less runs unpaced
+        double target_frame_rate = 60.0;
+
+        /// Render frame N on a render thread while frame N+1 simulates
+        bool pipelined_rendering = false;
+
         std::string serialize() const
         {
             JsonDocument doc;
@@ -26,6 +35,9 @@ namespace Engine
             root.set("engine_version", engine_version);
             root.set("project_definition_version", project_definition_version);
             root.set("last_open_stage", last_open_stage);
+            root.set("worker_thread_count", worker_thread_count);
+            root.set("target_frame_rate", target_frame_rate);
+            root.set("pipelined_rendering", pipelined_rendering);
 
             return doc.to_text();
         }
@@ -53,6 +65,16 @@ namespace Engine
             engine_version = engine_version_opt.value();
             project_definition_version = project_definition_version_opt.value();
             last_open_stage = last_open_stage_opt.value();
+
+            // Optional, older project files do not have it
+            if (root.has("worker_thread_count"))
+                worker_thread_count = root.get("worker_thread_count").as<int>().value_or(-1);
+
+            if (root.has("target_frame_rate"))
+                target_frame_rate = root.get("target_frame_rate").as<double>().value_or(60.0);
+
+            if (root.has("pipelined_rendering"))
+                pipelined_rendering = root.get("pipelined_rendering").as<bool>().value_or(false);
         }
     };
 }
\ No newline at end of file
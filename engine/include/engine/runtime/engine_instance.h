@@ -1,13 +1,18 @@
 #pragma once
 
+#include <iomanip>
+#include <memory>
+#include <sstream>
 #include <vector>
 #include <string>
 
 #include "engine/base/singleton.h"
 #include "engine/project_management/project_manager.h"
-#include "engine/graphics/render_manager.h"
 #include "engine/stage/stage_manager.h"
 #include "engine/asset/asset_manager.h"
+#include "engine/jobs/job_system.h"
+#include "engine/runtime/frame_pacer.h"
+#include "engine/runtime/frame_pipeline.h"
 
 namespace Engine
 {
@@ -34,6 +39,16 @@ namespace Engine
         }
         float get_time_passed() const { return time_passed; };
 
+        /// @brief Job system shared by stages, asset loading and other engine work, null before init
+        JobSystem *get_job_system() const { return job_system.get(); }
+
+        /// @brief Paces the main loop, configured from ProjectSettings::target_frame_rate in init
+        FramePacer &get_frame_pacer() { return frame_pacer; }
+
+        /// @brief Whether run() renders on a render thread, one frame behind the simulation
+        bool is_pipelined_rendering() const { return pipelined_rendering; }
+        void set_pipelined_rendering(bool pipelined) { pipelined_rendering = pipelined; }
+
         /// @brief Setup engine instance managers before running the engine
         /// @param project_path Path containing the "project.tetra" file
         virtual void init(const std::string &project_path);
@@ -41,5 +56,13 @@ namespace Engine
     protected:
         float delta_time;
         float time_passed;
+
+        std::unique_ptr<JobSystem> job_system;
+        FramePacer frame_pacer;
+
+        bool pipelined_rendering = false;
+        FramePipeline frame_pipeline;
+
+        void render_frame();
     };
 }
\ No newline at end of file
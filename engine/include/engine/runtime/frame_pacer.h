@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Engine
+{
+    /**
+     * @brief Caps a loop to a target rate without keeping a core busy.
+     *
+     * wait() sleeps through most of the remaining frame time and spins only for the last
+     * spin window before the deadline, where OS sleeps are too coarse to be trusted. Deadlines
+     * advance by a fixed period so wakeup latency does not add up into drift, but a frame that
+     * misses its deadline starts counting from now instead of rushing to catch up.
+     */
+    class FramePacer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// How late wait() returns, measured against the deadline it was waiting for
+        struct Stats
+        {
+            uint64_t frames = 0;
+            uint64_t missed_deadlines = 0;
+
+            double last_overshoot_milliseconds = 0.0;
+            double max_overshoot_milliseconds = 0.0;
+            double average_overshoot_milliseconds = 0.0;
+
+            /// How late the OS woke the coarse sleep up, the part the spin window has to absorb
+            double max_sleep_overshoot_milliseconds = 0.0;
+        };
+
+        /**
+         * @param target_rate Frames per second, 0 or less disables pacing.
+         */
+        explicit FramePacer(double target_rate = 60.0);
+
+        /**
+         * @brief Blocks until the next frame is due. Returns immediately if pacing is disabled.
+         */
+        void wait();
+
+        void set_target_rate(double target_rate);
+        double get_target_rate() const { return target_rate; }
+
+        /**
+         * @brief Time before the deadline spent spinning instead of sleeping.
+         *
+         * Should cover the scheduler's wakeup latency, see Stats::max_sleep_overshoot_milliseconds.
+         */
+        void set_spin_window(double seconds);
+        double get_spin_window() const { return std::chrono::duration<double>(spin_window).count(); }
+
+        const Stats &get_stats() const { return stats; }
+        void reset_stats() { stats = Stats{}; }
+
+    private:
+        double target_rate = 0.0;
+        clock::duration period = clock::duration::zero();
+        clock::duration spin_window = std::chrono::milliseconds(2);
+
+        clock::time_point deadline;
+        bool has_deadline = false;
+
+        Stats stats;
+    };
+}
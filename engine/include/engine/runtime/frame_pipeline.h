@@ -0,0 +1,94 @@
+#pragma once
+
+#include "engine/graphics/frame_packet.h"
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Engine
+{
+    /**
+     * @brief Double-buffered frame packets handed from the simulation thread to a render thread.
+     *
+     * The simulation thread fills one packet while the render thread draws the other, so frame N
+     * renders during the update of frame N+1. The simulation is never more than one frame ahead:
+     * begin_extract() blocks while the render thread still reads the packet it would overwrite.
+     *
+     * An exception thrown by the render function stops the render thread. It is rethrown from
+     * begin_extract() and submit() until stop() rethrows it one last time and clears it.
+     */
+    class FramePipeline
+    {
+    public:
+        using RenderFunction = std::function<void(const Graphics::FramePacket &)>;
+
+        /// Time the simulation thread spent blocked on the render thread, and the cost of the last render
+        struct Stats
+        {
+            uint64_t rendered_frames = 0;
+            double last_wait_milliseconds = 0.0;
+            double last_render_milliseconds = 0.0;
+        };
+
+        FramePipeline() = default;
+        ~FramePipeline();
+
+        FramePipeline(const FramePipeline &) = delete;
+        FramePipeline &operator=(const FramePipeline &) = delete;
+
+        /**
+         * @brief Starts the render thread, which calls @p render for every submitted packet.
+         */
+        void start(RenderFunction render);
+
+        /**
+         * @brief Renders the packets still pending and joins the render thread.
+         */
+        void stop();
+
+        bool is_running() const { return render_thread.joinable(); }
+
+        /**
+         * @brief Returns the packet to extract the current frame into, once the render thread is done with it.
+         */
+        Graphics::FramePacket &begin_extract();
+
+        /**
+         * @brief Hands the packet from begin_extract() to the render thread.
+         */
+        void submit();
+
+        /**
+         * @brief Blocks until every submitted packet has been rendered.
+         */
+        void wait_idle();
+
+        Stats get_stats() const;
+
+    private:
+        static constexpr size_t NO_PACKET = SIZE_MAX;
+
+        std::array<Graphics::FramePacket, 2> packets;
+        size_t write_index = 0;
+
+        // Guarded by mutex, as is stats
+        size_t pending_index = NO_PACKET;
+        size_t rendering_index = NO_PACKET;
+        bool stop_requested = false;
+        std::exception_ptr render_error;
+
+        mutable std::mutex mutex;
+        std::condition_variable condition;
+        std::thread render_thread;
+
+        RenderFunction render;
+        Stats stats;
+
+        void run_render_thread();
+        void rethrow_render_error();
+    };
+}
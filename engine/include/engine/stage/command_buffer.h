@@ -0,0 +1,184 @@
+#pragma once
+
+#include "engine/component/component.h"
+#include "engine/component/component_type.h"
+#include "engine/entity/entity_id.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+    class Stage;
+
+    /**
+     * @brief Records structural changes to a stage so they can be applied later in one batch.
+     *
+     * Creating or destroying entities and adding or removing components moves rows between
+     * archetypes, which invalidates iteration and can not happen while systems run in parallel.
+     * A command buffer only appends to its own arrays, so each thread can record into its own
+     * buffer without locking. CommandBufferPool::playback applies them at the frame's sync point.
+     */
+    class CommandBuffer
+    {
+        friend class CommandBufferPool;
+
+    public:
+        /// Placeholder for an entity created by this buffer, usable in later commands of the same buffer
+        struct PendingEntity
+        {
+            uint32_t index;
+        };
+
+        PendingEntity create_entity(std::string name);
+
+        void destroy_entity(EntityID entity);
+        void destroy_entity(PendingEntity entity);
+
+        /**
+         * @brief Adds @p component, moved in, to the entity when the buffer is played back.
+         */
+        template <typename T>
+        void add_component(EntityID entity, T component = T())
+        {
+            record_add(target_of(entity), make_pending(std::move(component)));
+        }
+
+        template <typename T>
+        void add_component(PendingEntity entity, T component = T())
+        {
+            record_add(target_of(entity), make_pending(std::move(component)));
+        }
+
+        template <typename T>
+        void remove_component(EntityID entity)
+        {
+            record_remove(target_of(entity), checked_type_id<T>());
+        }
+
+        template <typename T>
+        void remove_component(PendingEntity entity)
+        {
+            record_remove(target_of(entity), checked_type_id<T>());
+        }
+
+        bool empty() const { return commands.empty(); }
+        size_t size() const { return commands.size(); }
+
+        void clear();
+
+    private:
+        static constexpr uint32_t NOT_PENDING = UINT32_MAX;
+
+        enum class CommandType : uint8_t
+        {
+            CreateEntity,
+            DestroyEntity,
+            AddComponent,
+            RemoveComponent
+        };
+
+        /// Either an existing entity or the index of an entity created by this buffer
+        struct Target
+        {
+            EntityID entity = EntityID::Invalid;
+            uint32_t pending = NOT_PENDING;
+        };
+
+        struct Command
+        {
+            CommandType type;
+            Target target;
+            ComponentTypeID component_type = INVALID_COMPONENT_TYPE;
+
+            // Index into names for CreateEntity, into components for AddComponent
+            uint32_t payload = 0;
+        };
+
+        std::vector<Command> commands;
+        std::vector<std::string> names;
+        std::vector<std::unique_ptr<Component>> components;
+
+        uint32_t pending_entity_count = 0;
+
+        static Target target_of(EntityID entity) { return {entity, NOT_PENDING}; }
+
+        Target target_of(PendingEntity entity) const
+        {
+            if (entity.index >= pending_entity_count)
+                throw std::runtime_error("PendingEntity does not belong to this command buffer");
+
+            return {EntityID::Invalid, entity.index};
+        }
+
+        template <typename T>
+        static ComponentTypeID checked_type_id()
+        {
+            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+            ComponentTypeID type_id = component_type_id<T>();
+            if (type_id == INVALID_COMPONENT_TYPE)
+                throw std::runtime_error("Component type is not registered in ComponentRegistry!");
+
+            return type_id;
+        }
+
+        template <typename T>
+        static std::unique_ptr<Component> make_pending(T &&component)
+        {
+            ComponentTypeID type_id = checked_type_id<std::decay_t<T>>();
+
+            std::unique_ptr<Component> pending = std::make_unique<std::decay_t<T>>(std::forward<T>(component));
+            pending->type_id = type_id;
+
+            return pending;
+        }
+
+        void record_add(Target target, std::unique_ptr<Component> component);
+        void record_remove(Target target, ComponentTypeID type_id);
+    };
+
+    /**
+     * @brief One CommandBuffer per thread for a stage, played back together.
+     *
+     * get_local() only locks the first time a thread asks for its buffer.
+     */
+    class CommandBufferPool
+    {
+    public:
+        CommandBufferPool();
+
+        CommandBufferPool(const CommandBufferPool &) = delete;
+        CommandBufferPool &operator=(const CommandBufferPool &) = delete;
+
+        /**
+         * @brief Returns the buffer of the calling thread.
+         */
+        CommandBuffer &get_local();
+
+        /**
+         * @brief Applies and clears every buffer. Must not run while systems are recording.
+         *
+         * Commands are coalesced per entity: entities created and destroyed in the same batch are
+         * never created, changes to entities that get destroyed are dropped, and all component
+         * additions and removals of an entity are applied with a single archetype move.
+         */
+        void playback(Stage &stage);
+
+        bool empty() const;
+
+    private:
+        // Distinguishes pools in the per-thread cache, addresses can be reused
+        uint64_t pool_id;
+
+        mutable std::mutex buffers_mutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> buffers;
+    };
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "engine/component/component_column.h"
+#include "engine/component/component_id.h"
+#include "engine/component/component_type.h"
+#include "engine/entity/entity_id.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+    class Stage;
+
+    /**
+     * @brief In-memory template of an entity subtree and its components.
+     *
+     * Baking copies the subtree once into per-archetype columns. EntityManager::instantiate then
+     * clones it by appending whole template columns to the target archetypes and assigning fresh
+     * entity and component IDs, without going through serialization. Component types that
+     * override Component::remap_references get their references into the subtree redirected to
+     * the new instance.
+     *
+     * Every component type in the subtree must be copy constructible.
+     */
+    class Prefab
+    {
+        friend class EntityManager;
+        friend class ComponentManager;
+
+    public:
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        /**
+         * @brief Copies @p root and all of its descendants out of @p stage.
+         *
+         * Throws if @p root does not exist or a component type in the subtree can not be copied.
+         */
+        static Prefab bake(Stage &stage, const EntityID &root);
+
+        Prefab() = default;
+
+        Prefab(Prefab &&) = default;
+        Prefab &operator=(Prefab &&) = default;
+
+        size_t get_entity_count() const { return entities.size(); }
+        size_t get_component_count() const { return component_count; }
+
+    private:
+        struct PrefabEntity
+        {
+            std::string name;
+
+            // Index of the parent within the prefab, NO_PARENT for the root
+            uint32_t parent = NO_PARENT;
+            bool enabled = true;
+        };
+
+        /// Components of every prefab entity with one signature, one template row per entity
+        struct PrefabArchetype
+        {
+            ComponentSignature signature;
+            std::vector<ComponentTypeID> types;
+            std::vector<std::unique_ptr<ComponentColumnBase>> columns;
+            std::vector<uint32_t> entities;
+
+            // Position of the first component of this block in the per-instance component order
+            uint32_t component_offset = 0;
+        };
+
+        // Breadth-first, so every parent comes before its children
+        std::vector<PrefabEntity> entities;
+        std::vector<PrefabArchetype> archetypes;
+        size_t component_count = 0;
+
+        bool has_disabled = false;
+        bool remaps_references = false;
+
+        // Source IDs at bake time to their position within an instance
+        std::unordered_map<EntityID, uint32_t> entity_lookup;
+        std::unordered_map<ComponentID, uint32_t> component_lookup;
+    };
+}
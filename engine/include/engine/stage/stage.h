@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include "engine/graphics/viewport.h"
 #include "engine/entity/entity_manager.h"
+#include "engine/component/component_view.h"
+#include "engine/system/system_scheduler.h"
+#include "engine/stage/command_buffer.h"
+#include "engine/component/3d/transform_propagation.h"
 #include "engine/serialization/serializable.h"
 #include "engine/data/guid.h"
 #include "engine/base/runtime_object_base.h"
@@ -12,11 +16,29 @@ namespace Engine::Serialization
     class SerializationContext;
 }
 
+namespace Engine::Graphics
+{
+    class Viewport;
+}
+
 namespace Engine
 {
     using Engine::Serialization::SerializationContext;
 
     class ComponentManager;
+    class JobSystem;
+
+    /**
+     * @brief How Stage::update calls Component::update.
+     */
+    enum class ComponentUpdateMode
+    {
+        /// Entity by entity, every component through the vtable
+        PerEntity,
+
+        /// Type by type over the archetype columns, skipping types that do not override update
+        TypeBatched
+    };
 
     class Stage : public Serialization::Serializable, public RuntimeObjectBase
     {
@@ -30,15 +52,60 @@ namespace Engine
         void update(const float delta_time);
         void physics_update(const float delta_time);
 
+        /**
+         * @brief Advances the stage by @p frame_time seconds: physics_update in fixed steps, then one update.
+         *
+         * The step accumulator belongs to the stage, so stages with different step rates can be
+         * ticked independently. At most MAX_FIXED_STEPS_PER_TICK steps run per call, time beyond
+         * that is dropped instead of piling up.
+         *
+         * @return Number of fixed steps that ran.
+         */
+        size_t tick(double frame_time);
+
+        static constexpr size_t MAX_FIXED_STEPS_PER_TICK = 8;
+
+        double get_fixed_timestep() const { return fixed_timestep; }
+        void set_fixed_timestep(double fixed_timestep) { this->fixed_timestep = fixed_timestep; }
+
         GUID get_guid() const { return guid; }
         std::string get_name() const { return name; }
 
+        /**
+         * @brief True for stages without a viewport, and for every stage in a TETRA_HEADLESS build.
+         */
         bool is_headless() const;
         bool has_requested_shutdown() const;
-        void request_shutdown() { requested_shutdown = true; };
+        void request_shutdown() { requested_shutdown.store(true, std::memory_order_release); };
 
         EntityManager &get_entity_manager();
         ComponentManager &get_component_manager();
+        SystemScheduler &get_system_scheduler() { return system_scheduler; }
+
+        ComponentUpdateMode get_update_mode() const { return update_mode; }
+        void set_update_mode(ComponentUpdateMode mode) { update_mode = mode; }
+
+        /**
+         * @brief Returns the calling thread's command buffer for deferred structural changes.
+         *
+         * Recorded commands are applied by playback_commands(), which update() calls once the
+         * entities and systems of the frame have run.
+         */
+        CommandBuffer &get_command_buffer() { return command_buffers.get_local(); }
+        void playback_commands() { command_buffers.playback(*this); }
+
+        /// @brief Job system used to run this stage's systems in parallel, null runs them on the calling thread
+        JobSystem *get_job_system() const { return job_system; }
+        void set_job_system(JobSystem *job_system) { this->job_system = job_system; }
+
+        /**
+         * @brief Returns a cached view over every entity that owns all of Ts.
+         *
+         * Defined in stage.inl, which component_manager.h pulls in.
+         * @see ComponentManager::view
+         */
+        template <typename... Ts>
+        View<Ts...> view();
 
         void serialize(SerializationContext &ctx) const override;
         void deserialize(SerializationContext &ctx) override;
@@ -48,10 +115,20 @@ namespace Engine
         std::string name;
 
         bool headless;
-        bool requested_shutdown = false;
+        std::atomic<bool> requested_shutdown{false};
+
+        double fixed_timestep = 1.0 / 60.0;
+        double accumulator = 0.0;
+
+        ComponentUpdateMode update_mode = ComponentUpdateMode::PerEntity;
         std::shared_ptr<Graphics::Viewport> viewport;
 
         std::unique_ptr<EntityManager> entity_manager;
         std::unique_ptr<ComponentManager> component_manager;
+
+        SystemScheduler system_scheduler;
+        CommandBufferPool command_buffers;
+        TransformPropagation transform_propagation;
+        JobSystem *job_system = nullptr;
     };
 }
\ No newline at end of file
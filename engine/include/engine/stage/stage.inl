@@ -0,0 +1,13 @@
+#pragma once
+
+#include "engine/stage/stage.h"
+#include "engine/component/component_manager.h"
+
+namespace Engine
+{
+    template <typename... Ts>
+    View<Ts...> Stage::view()
+    {
+        return component_manager->view<Ts...>();
+    }
+}
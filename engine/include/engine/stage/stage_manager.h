@@ -6,10 +6,25 @@
 #include "engine/base/singleton.h"
 #include "engine/debug/logging/logger.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine
 {
+    /**
+     * @brief Owns the current stage and any number of independent stages registered next to it.
+     *
+     * The current stage is driven by EngineInstance on the main thread. Registered stages are
+     * meant for headless simulation, e.g. one match per stage on a dedicated server, and each
+     * run on a thread of their own through start_stages(), which EngineInstance::run calls when
+     * any are registered. Stages share no mutable state, so they only synchronize on the job
+     * system they submit system jobs to.
+     */
     class StageManager : public Singleton<StageManager>
     {
     public:
@@ -18,6 +33,8 @@ namespace Engine
             Logger::log("[StageManager] Initialization complete", LogLevel::Info);
         }
 
+        ~StageManager() { stop_stages(); }
+
         Stage *get_current_stage()
         {
             return current_stage.get();
@@ -28,8 +45,65 @@ namespace Engine
         void load_new_stage();
         void load_stage();
 
+        /**
+         * @brief Creates an empty headless stage and registers it under its GUID.
+         * @return The stage, owned by the manager until destroy_stage.
+         */
+        Stage *create_stage();
+
+        /**
+         * @brief Creates a headless stage from the stage file at @p path and registers it under its GUID.
+         *
+         * Throws if the file cannot be read. Lets a dedicated server load one stage per match.
+         */
+        Stage *create_stage(const std::string &path);
+
+        /**
+         * @brief Returns the registered stage with @p guid, or nullptr.
+         */
+        Stage *get_stage(const GUID &guid) const;
+
+        /**
+         * @brief Destroys a registered stage. Throws while start_stages() threads are running.
+         */
+        void destroy_stage(const GUID &guid);
+
+        size_t get_stage_count() const;
+
+        /**
+         * @brief Starts one thread per registered stage that runs its fixed-step loop.
+         *
+         * Each thread measures its own frame time, calls Stage::tick and sleeps until the stage's
+         * next fixed step is due. A thread ends when its stage requests shutdown or stop_stages()
+         * is called. An exception thrown by a tick is logged and shuts down that stage only.
+         * Stages registered while running are not started.
+         */
+        void start_stages();
+
+        /**
+         * @brief Signals every stage thread to finish its current tick and waits for them.
+         */
+        void stop_stages();
+
+        bool is_running() const { return !stage_threads.empty(); }
+
+        /**
+         * @brief Sets the job system handed to every stage created from now on.
+         */
+        void set_job_system(JobSystem *job_system) { this->job_system = job_system; }
+
     private:
+        JobSystem *job_system = nullptr;
+
         std::unique_ptr<Stage> current_stage = nullptr;
+
+        mutable std::mutex registry_mutex;
         std::unordered_map<GUID, std::unique_ptr<Stage>> stage_registry;
+
+        std::vector<std::thread> stage_threads;
+        std::atomic<bool> stop_requested{false};
+
+        Stage *register_stage(std::unique_ptr<Stage> stage_ptr);
+        void run_stage(Stage &stage);
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity_manager.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+    class Stage;
+
+    /**
+     * @brief Fixed number of stage snapshots for rollback, the oldest one overwritten first.
+     *
+     * A capture copies the entity records and every archetype column into the slot for its
+     * frame, skipping serialization entirely. Slots keep their buffers between captures, so once
+     * every slot has been used with a stage of similar size capturing no longer allocates.
+     * Restoring copies a slot back into the stage the same way.
+     *
+     * Every component type in the stage must be copy assignable. A ring belongs to one stage and
+     * is invalidated by loading that stage again.
+     */
+    class StageSnapshotRing
+    {
+    public:
+        static constexpr uint64_t NO_FRAME = UINT64_MAX;
+
+        /// Cost of the most recent capture and restore
+        struct Stats
+        {
+            size_t capture_bytes = 0;
+            double capture_milliseconds = 0.0;
+            double restore_milliseconds = 0.0;
+        };
+
+        explicit StageSnapshotRing(size_t capacity);
+
+        /**
+         * @brief Saves the state of @p stage as @p frame, replacing the snapshot @p capacity frames older.
+         */
+        void capture(Stage &stage, uint64_t frame);
+
+        /**
+         * @brief Rewinds @p stage to the snapshot of @p frame.
+         * @return false if @p frame was never captured or has been overwritten since.
+         */
+        bool restore(Stage &stage, uint64_t frame);
+
+        bool contains(uint64_t frame) const;
+
+        /**
+         * @brief Newest captured frame, or NO_FRAME before the first capture.
+         */
+        uint64_t get_latest_frame() const { return latest_frame; }
+
+        size_t get_capacity() const { return slots.size(); }
+        const Stats &get_stats() const { return stats; }
+
+    private:
+        struct Slot
+        {
+            uint64_t frame = NO_FRAME;
+            EntityManager::Snapshot entities;
+            ComponentManager::Snapshot components;
+        };
+
+        std::vector<Slot> slots;
+        uint64_t latest_frame = NO_FRAME;
+        Stats stats;
+    };
+}
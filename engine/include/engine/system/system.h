@@ -0,0 +1,89 @@
+#pragma once
+
+#include "engine/component/component_type.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace Engine
+{
+    class Stage;
+
+    /**
+     * @brief Component types a system touches, used by the scheduler to find conflicts.
+     */
+    struct SystemAccess
+    {
+        ComponentSignature reads;
+        ComponentSignature writes;
+
+        /// Runs alone, for systems that touch state outside of components
+        bool exclusive = false;
+
+        /**
+         * @brief Checks whether two systems can not run at the same time.
+         *
+         * Two systems conflict when either writes a type the other reads or writes.
+         */
+        bool conflicts_with(const SystemAccess &other) const
+        {
+            if (exclusive || other.exclusive)
+                return true;
+
+            return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any();
+        }
+    };
+
+    /**
+     * @brief Logic that runs once per frame over the components of a stage.
+     *
+     * Systems declare the component types they read and write in their constructor. The
+     * SystemScheduler runs systems whose access does not conflict at the same time on worker
+     * threads, so update() must not touch components it did not declare. Structural changes go
+     * through Stage::get_command_buffer() and are applied after all systems have run.
+     */
+    class System
+    {
+        friend class SystemScheduler;
+
+    public:
+        explicit System(std::string name) : name(std::move(name)) {}
+        virtual ~System() = default;
+
+        virtual void update(Stage &stage, float delta_time) = 0;
+
+        const std::string &get_name() const { return name; }
+        const SystemAccess &get_access() const { return access; }
+
+        /**
+         * @brief Change tick the system last ran at, 0 before its first run.
+         *
+         * Pass it to View::changed_since or View::added_since to visit only what changed since then.
+         */
+        uint32_t get_last_run_tick() const { return last_run_tick; }
+
+    protected:
+        template <typename... Ts>
+        void reads() { access.reads |= signature_of<Ts...>(); }
+
+        template <typename... Ts>
+        void writes() { access.writes |= signature_of<Ts...>(); }
+
+        void set_exclusive() { access.exclusive = true; }
+
+    private:
+        std::string name;
+        SystemAccess access;
+        uint32_t last_run_tick = 0;
+
+        template <typename... Ts>
+        static ComponentSignature signature_of()
+        {
+            ComponentSignature signature;
+            if (!make_component_signature<Ts...>(signature))
+                throw std::runtime_error("System accesses a component type that is not registered");
+
+            return signature;
+        }
+    };
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "engine/system/system.h"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+    class Stage;
+    class JobSystem;
+
+    /**
+     * @brief Runs the systems of a stage, in parallel where their component access allows it.
+     *
+     * Systems are grouped into layers. A system goes into the first layer after every earlier
+     * registered system it conflicts with, so conflicting systems keep their registration
+     * order while independent ones share a layer and run at the same time.
+     */
+    class SystemScheduler
+    {
+    public:
+        SystemScheduler() = default;
+        ~SystemScheduler() = default;
+
+        SystemScheduler(const SystemScheduler &) = delete;
+        SystemScheduler &operator=(const SystemScheduler &) = delete;
+
+        /**
+         * @brief Constructs a system of type T and appends it to the schedule.
+         * @return The system, owned by the scheduler.
+         */
+        template <typename T, typename... Args>
+        T *add_system(Args &&...args)
+        {
+            static_assert(std::is_base_of<System, T>::value, "T must derive from System");
+
+            auto system = std::make_unique<T>(std::forward<Args>(args)...);
+            T *system_ptr = system.get();
+
+            systems.push_back(std::move(system));
+            schedule_dirty = true;
+
+            return system_ptr;
+        }
+
+        /**
+         * @brief Runs every system once, layer by layer.
+         *
+         * Layers run on the stage's job system, the calling thread runs one system of each layer
+         * itself and helps with the rest. Without a job system every system runs on the calling
+         * thread. If a system throws, the exception is rethrown after its layer has finished.
+         *
+         * The stage's change tick advances after every layer, see System::get_last_run_tick.
+         */
+        void run(Stage &stage, float delta_time);
+
+        /**
+         * @brief Returns the systems grouped into layers that may run concurrently.
+         */
+        const std::vector<std::vector<System *>> &get_layers();
+
+        size_t get_system_count() const { return systems.size(); }
+
+    private:
+        std::vector<std::unique_ptr<System>> systems;
+        std::vector<std::vector<System *>> layers;
+
+        bool schedule_dirty = false;
+
+        void build_layers();
+        void run_layer(Stage &stage, const std::vector<System *> &layer, JobSystem *job_system, float delta_time);
+    };
+}
@@ -1,20 +1,22 @@
 ﻿#include "engine/asset/asset_manager.h"
+#include "engine/jobs/job_system.h"
 
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace fs = std::filesystem;
 
 namespace Engine::Asset
 {
-    void AssetManager::init(const std::string &asset_root)
+    void AssetManager::init(const std::string &asset_root, JobSystem *job_system)
     {
         this->asset_root = asset_root;
-        scan_assets();
+        scan_assets(job_system);
     }
 
-    void AssetManager::scan_assets()
+    void AssetManager::scan_assets(JobSystem *job_system)
     {
         if (!fs::exists(asset_root))
             throw std::runtime_error("Asset root directory does not exist: " + asset_root);
@@ -22,54 +24,76 @@ namespace Engine::Asset
         if (!fs::is_directory(asset_root))
             throw std::runtime_error("Asset root path is not a directory: " + asset_root);
 
+        std::vector<std::string> asset_paths;
+
         for (const auto &entry : fs::recursive_directory_iterator(asset_root))
         {
             if (entry.is_directory())
                 continue;
 
-            const std::string asset_path = entry.path().string();
-
             if (entry.path().extension() == ASSET_META_EXTENSION)
                 continue;
 
-            std::string meta_path = asset_path + ASSET_META_EXTENSION;
+            asset_paths.push_back(entry.path().string());
+        }
+
+        // Every asset has its own meta file, so they can be read and written independently
+        std::vector<AssetMeta> asset_metas(asset_paths.size());
+
+        auto read_range = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                asset_metas[i] = read_or_create_meta(asset_paths[i]);
+        };
+
+        if (job_system)
+            job_system->parallel_for(asset_paths.size(), 0, read_range);
+        else
+            read_range(0, asset_paths.size());
+
+        for (const AssetMeta &asset_meta : asset_metas)
+            register_asset(asset_meta);
+    }
 
-            AssetMeta asset_meta;
-            if (fs::exists(meta_path))
-            {
-                std::ifstream in(meta_path);
-                if (!in.is_open())
-                    throw std::runtime_error("Failed to open meta file: " + meta_path);
+    AssetMeta AssetManager::read_or_create_meta(const std::string &asset_path) const
+    {
+        std::string meta_path = asset_path + ASSET_META_EXTENSION;
 
-                std::string meta_json(
-                    (std::istreambuf_iterator<char>(in)),
-                    (std::istreambuf_iterator<char>()));
+        AssetMeta asset_meta;
+        if (fs::exists(meta_path))
+        {
+            std::ifstream in(meta_path);
+            if (!in.is_open())
+                throw std::runtime_error("Failed to open meta file: " + meta_path);
 
-                asset_meta.deserialize(meta_json);
-            }
-            else
-            {
-                asset_meta.guid = GUID::generate();
+            std::string meta_json(
+                (std::istreambuf_iterator<char>(in)),
+                (std::istreambuf_iterator<char>()));
 
-                std::error_code ec;
-                auto relative_path = fs::relative(entry.path(), asset_root, ec);
-                if (ec)
-                    throw std::runtime_error("Failed to compute relative path for: " + asset_path);
+            asset_meta.deserialize(meta_json);
+        }
+        else
+        {
+            asset_meta.guid = GUID::generate();
 
-                asset_meta.path = relative_path.string();
+            std::error_code ec;
+            auto relative_path = fs::relative(fs::path(asset_path), asset_root, ec);
+            if (ec)
+                throw std::runtime_error("Failed to compute relative path for: " + asset_path);
 
-                // TODO: Change this to a better way to handle types
-                asset_meta.type = entry.path().extension().string();
+            asset_meta.path = relative_path.string();
 
-                std::ofstream out(meta_path);
-                if (!out.is_open())
-                    throw std::runtime_error("Failed to create meta file: " + meta_path);
+            // TODO: Change this to a better way to handle types
+            asset_meta.type = fs::path(asset_path).extension().string();
 
-                out << asset_meta.serialize();
-            }
+            std::ofstream out(meta_path);
+            if (!out.is_open())
+                throw std::runtime_error("Failed to create meta file: " + meta_path);
 
-            register_asset(asset_meta);
+            out << asset_meta.serialize();
         }
+
+        return asset_meta;
     }
 
     void AssetManager::register_asset(const AssetMeta &asset_meta)
@@ -1,5 +1,7 @@
 ﻿#include "engine/component/component_registry.h"
 #include "engine/component/3d/transform_3d.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/math/matrix4_batch.h"
 
 namespace Engine
 {
@@ -8,78 +10,131 @@ namespace Engine
         position.x += delta.x;
         position.y += delta.y;
         position.z += delta.z;
+
+        mark_dirty();
     }
 
     void Transform3D::rotate_degrees(const Vector3 &delta)
     {
-        rotation_radians.x += delta.x;
-        rotation_radians.y += delta.y;
-        rotation_radians.z += delta.z;
+        // Compose onto the quaternion, summing Euler angles drifts once the axes couple
+        rotation = (Quaternion::from_euler(delta * DEG2RAD) * rotation).normalized();
+        rotation_radians = rotation.to_euler();
+        refresh_rotation();
+    }
 
-        auto wrap_angle = [](float &a)
-        {
-            if (a > 360.0f || a < -360.0f)
-            {
-                a = std::fmod(a, 360.0f);
-            }
-        };
+    void Transform3D::set_rotation_radians(const Vector3 &rotation_radians)
+    {
+        this->rotation_radians = rotation_radians;
 
-        wrap_angle(rotation_radians.x);
-        wrap_angle(rotation_radians.y);
-        wrap_angle(rotation_radians.z);
+        rotation = Quaternion::from_euler(rotation_radians).normalized();
+        refresh_rotation();
     }
-    void Transform3D::serialize(Serialization::SerializationContext &ctx) const
+
+    void Transform3D::set_rotation(const Quaternion &q)
     {
-        Component::serialize(ctx);
+        rotation = q.normalized();
+        rotation_radians = rotation.to_euler();
+        refresh_rotation();
+    }
 
-        ctx.write("x", position.x);
-        ctx.write("y", position.y);
-        ctx.write("z", position.z);
+    void Transform3D::refresh_rotation()
+    {
+        rotation_matrix = Matrix4::from_quaternion(rotation);
+        mark_dirty();
     }
 
-    Vector3 Transform3D::get_forward() const
+    void Transform3D::mark_dirty()
     {
-        Quaternion q = Quaternion::from_euler(rotation_radians.x, rotation_radians.y, rotation_radians.z);
+        // Already recorded, new transforms are recorded by on_attach
+        if (dirty)
+            return;
 
-        Vector3 local_forward = Vector3(0.0f, 0.0f, -1.0f);
-        Vector3 world_forward = q * local_forward;
+        dirty = true;
 
-        return world_forward.normalized();
+        if (entity_manager)
+            entity_manager->record_transform_change(owner_id);
     }
 
-    Vector3 Transform3D::get_up() const
+    void Transform3D::on_attach()
     {
-        Quaternion q = Quaternion::from_euler(rotation_radians.x, rotation_radians.y, rotation_radians.z);
-
-        Vector3 local_up = Vector3(0.0f, 1.0f, 0.0f);
-        Vector3 world_up = q * local_up;
+        dirty = true;
 
-        return world_up.normalized();
+        if (entity_manager)
+            entity_manager->record_transform_change(owner_id);
     }
 
-    Vector3 Transform3D::get_right() const
+    void Transform3D::serialize(Serialization::SerializationContext &ctx) const
     {
-        Vector3 euler_rad = rotation_radians;
-        Quaternion q = Quaternion::from_euler(rotation_radians.x, rotation_radians.y, rotation_radians.z);
+        Component::serialize(ctx);
 
-        Vector3 local_right = Vector3(1.0f, 0.0f, 0.0f);
-        Vector3 world_right = q * local_right;
+        ctx.write("x", position.x);
+        ctx.write("y", position.y);
+        ctx.write("z", position.z);
 
-        return world_right.normalized();
+        ctx.begin_object_key("rotation");
+        ctx.write("x", rotation.x);
+        ctx.write("y", rotation.y);
+        ctx.write("z", rotation.z);
+        ctx.write("w", rotation.w);
+        ctx.end_object();
+
+        ctx.begin_object_key("scale");
+        ctx.write("x", scale.x);
+        ctx.write("y", scale.y);
+        ctx.write("z", scale.z);
+        ctx.end_object();
     }
 
     Matrix4 Transform3D::get_local_matrix() const
     {
-        Matrix4 t = Matrix4::identity().translate(position);
+        // T * R * S scales the basis columns of R and fills in the translation column
+        Matrix4 m = rotation_matrix;
+        for (int r = 0; r < 3; r++)
+        {
+            m[0][r] *= scale.x;
+            m[1][r] *= scale.y;
+            m[2][r] *= scale.z;
+        }
 
-        Vector3 euler_rad = rotation_radians;
-        Quaternion q = Quaternion::from_euler(euler_rad.x, euler_rad.y, euler_rad.z);
-        Matrix4 r = Matrix4::from_quaternion(q);
+        m[3][0] = position.x;
+        m[3][1] = position.y;
+        m[3][2] = position.z;
 
-        Matrix4 m = t * r;
         return m;
     }
 
+    void Transform3D::compute_local_matrices(const Transform3D *transforms, size_t count, Matrix4 *out)
+    {
+        // Transposed into structure-of-arrays chunks on the stack so the kernel can load whole registers
+        constexpr size_t CHUNK = 256;
+        float soa[10][CHUNK];
+
+        TRSBatch batch = {soa[0], soa[1], soa[2], soa[3], soa[4], soa[5], soa[6], soa[7], soa[8], soa[9]};
+
+        for (size_t first = 0; first < count; first += CHUNK)
+        {
+            size_t chunk_count = count - first < CHUNK ? count - first : CHUNK;
+
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                const Transform3D &transform = transforms[first + i];
+
+                soa[0][i] = transform.position.x;
+                soa[1][i] = transform.position.y;
+                soa[2][i] = transform.position.z;
+                soa[3][i] = transform.rotation.x;
+                soa[4][i] = transform.rotation.y;
+                soa[5][i] = transform.rotation.z;
+                soa[6][i] = transform.rotation.w;
+                soa[7][i] = transform.scale.x;
+                soa[8][i] = transform.scale.y;
+                soa[9][i] = transform.scale.z;
+            }
+
+            compose_trs(batch, chunk_count, out + first);
+        }
+    }
+
     void Transform3D::deserialize(Serialization::SerializationContext &ctx)
     {
         Component::deserialize(ctx);
@@ -87,5 +142,30 @@ namespace Engine
         position.x = ctx.read<float>("x");
         position.y = ctx.read<float>("y");
         position.z = ctx.read<float>("z");
+
+        Quaternion q = Quaternion::identity();
+        if (ctx.has_object("rotation"))
+        {
+            ctx.begin_object_key("rotation");
+            q.x = ctx.read<float>("x");
+            q.y = ctx.read<float>("y");
+            q.z = ctx.read<float>("z");
+            q.w = ctx.read<float>("w");
+            ctx.end_object();
+        }
+
+        set_rotation(q);
+
+        scale = Vector3(1.0f);
+        if (ctx.has_object("scale"))
+        {
+            ctx.begin_object_key("scale");
+            scale.x = ctx.read<float>("x");
+            scale.y = ctx.read<float>("y");
+            scale.z = ctx.read<float>("z");
+            ctx.end_object();
+        }
+
+        mark_dirty();
     }
 }
@@ -0,0 +1,105 @@
+#include "engine/component/3d/transform_propagation.h"
+
+#include "engine/component/3d/transform_3d.h"
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity_manager.h"
+
+namespace Engine
+{
+    void TransformPropagation::run(EntityManager &entity_manager, ComponentManager &component_manager)
+    {
+        changed.clear();
+        entity_manager.take_transform_changes(changed);
+
+        if (entity_manager.get_hierarchy_version() != hierarchy_version)
+        {
+            hierarchy_version = entity_manager.get_hierarchy_version();
+
+            propagate_all(entity_manager, component_manager);
+            return;
+        }
+
+        for (EntityID entity : changed)
+        {
+            const Transform3D *transform = component_manager.read_component<Transform3D>(entity);
+
+            // Destroyed, or already rebuilt as part of an ancestor's subtree
+            if (!transform || !transform->dirty)
+                continue;
+
+            // Start from the topmost dirty transform so each subtree is walked once
+            EntityID root = entity;
+            for (const Entity *ancestor = entity_manager.get_entity_by_id(entity)->get_parent(); ancestor; ancestor = ancestor->get_parent())
+            {
+                const Transform3D *ancestor_transform = component_manager.read_component<Transform3D>(ancestor->get_id());
+                if (ancestor_transform && ancestor_transform->dirty)
+                    root = ancestor->get_id();
+            }
+
+            propagate_subtree(entity_manager, component_manager, root);
+        }
+    }
+
+    void TransformPropagation::propagate_all(EntityManager &entity_manager, ComponentManager &component_manager)
+    {
+        const EntityHierarchy &hierarchy = entity_manager.get_hierarchy();
+        const std::vector<EntityID> &order = hierarchy.get_order();
+        const std::vector<uint32_t> &parents = hierarchy.get_parent_indices();
+
+        world_matrices.assign(order.size(), nullptr);
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            uint32_t parent = parents[i];
+            const Matrix4 *parent_world = parent == EntityHierarchy::NO_PARENT ? nullptr : world_matrices[parent];
+
+            // Read only access, rebuilding the world matrix cache does not mark the transform changed
+            const Transform3D *transform = component_manager.read_component<Transform3D>(order[i]);
+            if (!transform)
+            {
+                world_matrices[i] = parent_world;
+                continue;
+            }
+
+            Matrix4 local = transform->get_local_matrix();
+            transform->world_matrix = parent_world ? *parent_world * local : local;
+            transform->dirty = false;
+
+            world_matrices[i] = &transform->world_matrix;
+        }
+    }
+
+    void TransformPropagation::propagate_subtree(EntityManager &entity_manager, ComponentManager &component_manager, EntityID root)
+    {
+        // Ancestors of the root are clean, the nearest one with a transform holds its parent space
+        const Matrix4 *root_parent_world = nullptr;
+        for (const Entity *ancestor = entity_manager.get_entity_by_id(root)->get_parent(); ancestor && !root_parent_world; ancestor = ancestor->get_parent())
+        {
+            if (const Transform3D *ancestor_transform = component_manager.read_component<Transform3D>(ancestor->get_id()))
+                root_parent_world = &ancestor_transform->world_matrix;
+        }
+
+        stack.clear();
+        stack.emplace_back(root, root_parent_world);
+
+        while (!stack.empty())
+        {
+            auto [entity_id, parent_world] = stack.back();
+            stack.pop_back();
+
+            const Matrix4 *world = parent_world;
+
+            if (const Transform3D *transform = component_manager.read_component<Transform3D>(entity_id))
+            {
+                Matrix4 local = transform->get_local_matrix();
+                transform->world_matrix = parent_world ? *parent_world * local : local;
+                transform->dirty = false;
+
+                world = &transform->world_matrix;
+            }
+
+            for (const EntityID &child : entity_manager.get_entity_by_id(entity_id)->get_child_ids())
+                stack.emplace_back(child, world);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include "engine/component/archetype.h"
+#include "engine/component/component_registry.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Engine
+{
+    Archetype::Archetype(std::vector<ComponentTypeID> types) : types(std::move(types))
+    {
+        assert(std::is_sorted(this->types.begin(), this->types.end()) && "Archetype types must be sorted.");
+
+        const ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+        if (!this->types.empty())
+            column_lookup.assign(this->types.back() + 1, -1);
+
+        columns.reserve(this->types.size());
+        for (size_t column = 0; column < this->types.size(); column++)
+        {
+            columns.push_back(registry.create_column(this->types[column]));
+            column_lookup[this->types[column]] = static_cast<int>(column);
+            signature.set(this->types[column]);
+        }
+    }
+
+    Component *Archetype::get_component(size_t row, ComponentTypeID type)
+    {
+        int column_index = get_column_index(type);
+        if (column_index < 0)
+            return nullptr;
+
+        return columns[column_index]->get(row);
+    }
+
+    size_t Archetype::push_entity(EntityID entity)
+    {
+        entities.push_back(entity);
+        return entities.size() - 1;
+    }
+
+    void Archetype::swap_remove(size_t row)
+    {
+        assert(row < entities.size() && "Archetype row out of range.");
+
+        // Close the hole inside the active range first, the last active row becomes the one to drop
+        if (row < active_count)
+        {
+            active_count--;
+            swap_rows(row, active_count);
+            row = active_count;
+        }
+
+        for (auto &column : columns)
+        {
+            column->swap_remove(row);
+        }
+
+        entities[row] = entities.back();
+        entities.pop_back();
+    }
+
+    void Archetype::swap_rows(size_t a, size_t b)
+    {
+        if (a == b)
+            return;
+
+        for (auto &column : columns)
+        {
+            column->swap_rows(a, b);
+        }
+
+        std::swap(entities[a], entities[b]);
+    }
+
+    size_t Archetype::activate_row(size_t row)
+    {
+        assert(row >= active_count && "Row is already active.");
+
+        size_t target = active_count++;
+        swap_rows(row, target);
+        return target;
+    }
+
+    size_t Archetype::activate_tail(size_t count)
+    {
+        assert(active_count + count <= entities.size() && "Tail overlaps the active range.");
+
+        size_t first = active_count;
+        size_t inactive = entities.size() - active_count - count;
+
+        // Swapping the front of the inactive block with the back of the tail is enough to make the tail contiguous
+        size_t swaps = std::min(inactive, count);
+        for (size_t i = 0; i < swaps; i++)
+            swap_rows(first + i, entities.size() - 1 - i);
+
+        active_count += count;
+        return first;
+    }
+
+    size_t Archetype::deactivate_row(size_t row)
+    {
+        assert(row < active_count && "Row is already inactive.");
+
+        size_t target = --active_count;
+        swap_rows(row, target);
+        return target;
+    }
+
+    void Archetype::reserve(size_t capacity)
+    {
+        entities.reserve(capacity);
+        for (auto &column : columns)
+        {
+            column->reserve(capacity);
+        }
+    }
+
+    void Archetype::assign(const Archetype &source)
+    {
+        assert(signature == source.signature && "Archetypes must store the same types.");
+
+        entities = source.entities;
+        active_count = source.active_count;
+
+        for (size_t column = 0; column < columns.size(); column++)
+            columns[column]->assign(*source.columns[column]);
+    }
+
+    void Archetype::clear()
+    {
+        entities.clear();
+        active_count = 0;
+
+        for (auto &column : columns)
+            column->clear();
+    }
+
+    size_t Archetype::get_byte_size() const
+    {
+        size_t bytes = entities.size() * sizeof(EntityID);
+        for (const auto &column : columns)
+            bytes += column->get_byte_size();
+
+        return bytes;
+    }
+}
@@ -0,0 +1,14 @@
+#include "engine/component/component.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+
+namespace Engine
+{
+    const Entity *Component::get_entity() const
+    {
+        if (!entity_manager)
+            return nullptr;
+
+        return entity_manager->get_entity_by_id(owner_id);
+    }
+}
@@ -1,7 +1,16 @@
 #include "engine/component/component_manager.h"
 #include "engine/component/component.h"
 #include "engine/component/component_registry.h"
+#include "engine/component/reference_remap.h"
 #include "engine/entity/entity_id.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/stage/prefab.h"
+#include "engine/stage/stage.h"
+
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
 
 namespace Engine
 {
@@ -10,30 +19,522 @@ namespace Engine
         stage = owner_stage_ptr;
 
         Logger::log_info("[ComponentManager] Initialization complete");
-        Logger::log_info("[ComponentManager] Loaded " + std::to_string(ComponentRegistry::get_instance().get_type_names().size()) + " components.");
+        Logger::log_info("[ComponentManager] Loaded " + std::to_string(ComponentRegistry::get_instance().get_type_count()) + " components.");
+    }
+
+    ComponentManager::~ComponentManager() = default;
+
+    Component *ComponentManager::create_component(EntityID owner_id, ComponentTypeID type_id)
+    {
+        if (!stage->get_entity_manager().has_entity(owner_id))
+        {
+            throw std::runtime_error("Cannot find entity with provided EntityID!");
+        }
+
+        Component *component = attach_component(owner_id, type_id, nullptr);
+
+        ComponentID component_id = allocate_id();
+        component_records[component_id.index] = {owner_id, type_id};
+
+        component->id = component_id;
+        component->set_owner(&stage->get_entity_manager(), owner_id);
+
+        component_created.invoke(component->get_handle());
+
+        return component;
+    }
+
+    void ComponentManager::create_components(const EntityID *owner_ids, size_t count, const ComponentSignature &signature)
+    {
+        if (count == 0 || signature.none())
+            return;
+
+        uint32_t max_index = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (find_location(owner_ids[i]))
+                throw std::runtime_error("create_components requires entities without components");
+
+            max_index = std::max(max_index, owner_ids[i].index);
+        }
+
+        if (max_index >= entity_locations.size())
+        {
+            entity_locations.resize(max_index + 1);
+            entity_signatures.resize(max_index + 1);
+        }
+
+        uint32_t archetype_index = get_or_create_archetype(signature);
+        Archetype &archetype = *archetypes[archetype_index];
+
+        size_t first_row = archetype.size();
+        size_t column_count = archetype.get_column_count();
+
+        archetype.reserve(first_row + count);
+        for (size_t column = 0; column < column_count; column++)
+            archetype.get_column(column).emplace_defaults(count, current_tick);
+
+        generations.reserve(generations.size() + count * column_count);
+        component_records.reserve(component_records.size() + count * column_count);
+
+        EntityManager *entity_manager = &stage->get_entity_manager();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            EntityID owner_id = owner_ids[i];
+            uint32_t row = static_cast<uint32_t>(archetype.push_entity(owner_id));
+
+            for (size_t column = 0; column < column_count; column++)
+            {
+                ComponentTypeID type_id = archetype.get_types()[column];
+                Component *component = archetype.get_column(column).get(row);
+
+                ComponentID component_id = allocate_id();
+                component_records[component_id.index] = {owner_id, type_id};
+
+                component->id = component_id;
+                component->type_id = type_id;
+                component->set_owner(entity_manager, owner_id);
+            }
+
+            entity_locations[owner_id.index] = {archetype_index, row};
+            entity_signatures[owner_id.index] = signature;
+        }
+
+        // New entities are active, move the whole batch in front of any inactive rows
+        first_row = archetype.activate_tail(count);
+        for (size_t row = first_row; row < archetype.size(); row++)
+            refresh_row(archetype_index, row);
+
+        components_created_batch.invoke({archetype_index, first_row, count});
+    }
+
+    void ComponentManager::instantiate_components(const Prefab &prefab, const EntityID *owner_ids, size_t count)
+    {
+        size_t entity_count = prefab.get_entity_count();
+        if (count == 0 || prefab.archetypes.empty())
+            return;
+
+        uint32_t max_index = 0;
+        for (size_t i = 0; i < count * entity_count; i++)
+            max_index = std::max(max_index, owner_ids[i].index);
+
+        if (max_index >= entity_locations.size())
+        {
+            entity_locations.resize(max_index + 1);
+            entity_signatures.resize(max_index + 1);
+        }
+
+        // New component IDs in the prefab's per-instance order, only needed to remap references
+        std::vector<ComponentID> component_ids;
+        if (prefab.remaps_references)
+            component_ids.resize(count * prefab.get_component_count());
+
+        generations.reserve(generations.size() + count * prefab.get_component_count());
+        component_records.reserve(component_records.size() + count * prefab.get_component_count());
+
+        EntityManager *entity_manager = &stage->get_entity_manager();
+
+        std::vector<ComponentBatch> batches;
+        batches.reserve(prefab.archetypes.size());
+
+        for (const Prefab::PrefabArchetype &block : prefab.archetypes)
+        {
+            uint32_t archetype_index = get_or_create_archetype(block.signature);
+            Archetype &archetype = *archetypes[archetype_index];
+
+            size_t rows = block.entities.size();
+            size_t total = rows * count;
+
+            archetype.reserve(archetype.size() + total);
+            for (size_t column = 0; column < block.types.size(); column++)
+                archetype.get_column(column).append_copies(*block.columns[column], count, current_tick);
+
+            for (size_t instance = 0; instance < count; instance++)
+            {
+                for (size_t template_row = 0; template_row < rows; template_row++)
+                {
+                    EntityID owner_id = owner_ids[instance * entity_count + block.entities[template_row]];
+                    uint32_t row = static_cast<uint32_t>(archetype.push_entity(owner_id));
+
+                    for (size_t column = 0; column < block.types.size(); column++)
+                    {
+                        Component *component = archetype.get_column(column).get(row);
+
+                        ComponentID component_id = allocate_id();
+                        component_records[component_id.index] = {owner_id, block.types[column]};
+
+                        component->id = component_id;
+                        component->set_owner(entity_manager, owner_id);
+
+                        if (prefab.remaps_references)
+                            component_ids[instance * prefab.get_component_count() + block.component_offset + column * rows + template_row] = component_id;
+                    }
+
+                    entity_locations[owner_id.index] = {archetype_index, row};
+                    entity_signatures[owner_id.index] = block.signature;
+                }
+            }
+
+            size_t first_row = archetype.activate_tail(total);
+            for (size_t row = first_row; row < archetype.size(); row++)
+                refresh_row(archetype_index, row);
+
+            batches.push_back({archetype_index, first_row, total});
+        }
+
+        if (prefab.remaps_references)
+        {
+            const ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+            for (size_t instance = 0; instance < count; instance++)
+            {
+                ReferenceRemap remap(prefab.entity_lookup, owner_ids + instance * entity_count,
+                                     prefab.component_lookup, component_ids.data() + instance * prefab.get_component_count());
+
+                for (const Prefab::PrefabArchetype &block : prefab.archetypes)
+                {
+                    for (size_t template_row = 0; template_row < block.entities.size(); template_row++)
+                    {
+                        const EntityLocation *location = find_location(owner_ids[instance * entity_count + block.entities[template_row]]);
+                        Archetype &archetype = *archetypes[location->archetype];
+
+                        for (size_t column = 0; column < block.types.size(); column++)
+                        {
+                            if (registry.remaps_references(block.types[column]))
+                                archetype.get_column(column).get(location->row)->remap_references(remap);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const ComponentBatch &batch : batches)
+            components_created_batch.invoke(batch);
+    }
+
+    void ComponentManager::apply_changes(EntityID owner_id, const ComponentSignature &removed, const std::vector<PendingComponent> &added)
+    {
+        if (!stage->get_entity_manager().has_entity(owner_id))
+        {
+            throw std::runtime_error("Cannot find entity with provided EntityID!");
+        }
+
+        const EntityLocation *source_location = find_location(owner_id);
+        EntityLocation previous = source_location ? *source_location : EntityLocation{};
+
+        Archetype *source_archetype = source_location ? archetypes[previous.archetype].get() : nullptr;
+        ComponentSignature current = source_archetype ? source_archetype->get_signature() : ComponentSignature{};
+
+        ComponentSignature kept = current & ~removed;
+        ComponentSignature signature = kept;
+
+        // Column type -> index into added, so the target archetype can find the pending sources
+        std::vector<int> pending_index;
+        for (size_t i = 0; i < added.size(); i++)
+        {
+            ComponentTypeID type_id = added[i].type;
+            if (kept.test(type_id))
+            {
+                Logger::log_warning("[ComponentManager] Skipped adding " + ComponentRegistry::get_instance().get_type_name(type_id) +
+                                    ", entity already has one");
+                continue;
+            }
+
+            if (type_id >= pending_index.size())
+                pending_index.resize(type_id + 1, -1);
+
+            pending_index[type_id] = static_cast<int>(i);
+            signature.set(type_id);
+        }
+
+        if (signature == current)
+            return;
+
+        // Removed components are destroyed together with the source row
+        if (source_archetype)
+        {
+            for (size_t column = 0; column < source_archetype->get_column_count(); column++)
+            {
+                if (!removed.test(source_archetype->get_types()[column]))
+                    continue;
+
+                Component *component = source_archetype->get_column(column).get(previous.row);
+
+                component_destroyed.invoke(component->get_handle());
+                release_id(component->get_id());
+            }
+        }
+
+        if (signature.none())
+        {
+            remove_row(previous.archetype, previous.row);
+            clear_location(owner_id);
+            return;
+        }
+
+        uint32_t target_index = get_or_create_archetype(signature);
+        Archetype &target = *archetypes[target_index];
+
+        uint32_t target_row = static_cast<uint32_t>(target.push_entity(owner_id));
+        std::vector<size_t> created_columns;
+
+        for (size_t column = 0; column < target.get_column_count(); column++)
+        {
+            ComponentColumnBase &target_column = target.get_column(column);
+            ComponentTypeID column_type = target.get_types()[column];
+
+            if (kept.test(column_type))
+            {
+                ComponentColumnBase &source_column = source_archetype->get_column(source_archetype->get_column_index(column_type));
+                target_column.push_moved_from(source_column, previous.row);
+                continue;
+            }
+
+            const PendingComponent &pending = added[pending_index[column_type]];
+
+            Component *component = pending.source ? target_column.push_moved(*pending.source, current_tick) : target_column.emplace_default(current_tick);
+            component->type_id = column_type;
+
+            ComponentID component_id = allocate_id();
+            component_records[component_id.index] = {owner_id, column_type};
+
+            component->id = component_id;
+            component->set_owner(&stage->get_entity_manager(), owner_id);
+
+            created_columns.push_back(column);
+        }
+
+        if (source_archetype)
+            remove_row(previous.archetype, previous.row);
+
+        set_location(owner_id, target_index, target_row);
+
+        for (size_t column : created_columns)
+            component_created.invoke(target.get_column(column).get(target_row)->get_handle());
+    }
+
+    Component *ComponentManager::get_component(EntityID owner_id, ComponentTypeID type_id)
+    {
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return nullptr;
+
+        Archetype &archetype = *archetypes[location->archetype];
+
+        int column_index = archetype.get_column_index(type_id);
+        if (column_index < 0)
+            return nullptr;
+
+        ComponentColumnBase &column = archetype.get_column(column_index);
+        column.mark_changed(location->row, current_tick);
+
+        return column.get(location->row);
+    }
+
+    const Component *ComponentManager::read_component(EntityID owner_id, ComponentTypeID type_id) const
+    {
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return nullptr;
+
+        return archetypes[location->archetype]->get_component(location->row, type_id);
+    }
+
+    bool ComponentManager::mark_changed(EntityID owner_id, ComponentTypeID type_id)
+    {
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return false;
+
+        Archetype &archetype = *archetypes[location->archetype];
+
+        int column_index = archetype.get_column_index(type_id);
+        if (column_index < 0)
+            return false;
+
+        archetype.get_column(column_index).mark_changed(location->row, current_tick);
+        return true;
+    }
+
+    ComponentSignature ComponentManager::get_signature(EntityID owner_id) const
+    {
+        if (!find_location(owner_id))
+            return {};
+
+        return entity_signatures[owner_id.index];
+    }
+
+    std::vector<EntityID> ComponentManager::get_entities_with(const ComponentSignature &required) const
+    {
+        std::vector<EntityID> matching;
+
+        for (const auto &archetype : archetypes)
+        {
+            if (!archetype->matches(required))
+                continue;
+
+            const std::vector<EntityID> &entities = archetype->get_entities();
+            matching.insert(matching.end(), entities.begin(), entities.end());
+        }
+
+        return matching;
+    }
+
+    const std::vector<uint32_t> &ComponentManager::get_matching_archetypes(const ComponentSignature &required)
+    {
+        {
+            std::shared_lock lock(query_cache_mutex);
+
+            auto cached = query_cache.find(required);
+            if (cached != query_cache.end())
+                return cached->second;
+        }
+
+        std::unique_lock lock(query_cache_mutex);
+
+        auto [it, inserted] = query_cache.try_emplace(required);
+        if (inserted)
+        {
+            for (uint32_t archetype_index = 0; archetype_index < archetypes.size(); archetype_index++)
+            {
+                if (archetypes[archetype_index]->matches(required))
+                    it->second.push_back(archetype_index);
+            }
+        }
+
+        return it->second;
     }
 
     void ComponentManager::destroy_component(const ComponentID id)
     {
-        auto it = component_list.find(id);
-        if (it == component_list.end())
+        Component *component = get_component_by_id(id);
+        if (!component)
             return;
 
-        component_destroyed.invoke(it->second);
+        ComponentRecord record = component_records[id.index];
 
-        component_list.erase(it);
+        component_destroyed.invoke(component->get_handle());
 
-        free_indices.push_back(id.index);
-        generations[id.index]++;
+        detach_component(record.owner, record.type);
+        release_id(id);
     }
 
-    Component *ComponentManager::get_component_by_id(const ComponentID id) const
+    Component *ComponentManager::get_component_by_id(const ComponentID id)
     {
-        auto it = component_list.find(id);
-        if (it == component_list.end())
+        if (id.index >= generations.size() || generations[id.index] != id.generation)
             return nullptr;
 
-        return it->second.get();
+        const ComponentRecord &record = component_records[id.index];
+        if (!record.owner.is_valid())
+            return nullptr;
+
+        return get_component(record.owner, record.type);
+    }
+
+    const Component *ComponentManager::read_component_by_id(const ComponentID id) const
+    {
+        if (id.index >= generations.size() || generations[id.index] != id.generation)
+            return nullptr;
+
+        const ComponentRecord &record = component_records[id.index];
+        if (!record.owner.is_valid())
+            return nullptr;
+
+        return read_component(record.owner, record.type);
+    }
+
+    size_t ComponentManager::get_component_count(ComponentTypeID type_id) const
+    {
+        if (type_id >= component_pools.size())
+            return 0;
+
+        size_t count = 0;
+        for (const PoolEntry &entry : component_pools[type_id])
+            count += archetypes[entry.archetype]->size();
+
+        return count;
+    }
+
+    ComponentTypeID ComponentManager::get_component_type(const ComponentID id) const
+    {
+        if (id.index >= generations.size() || generations[id.index] != id.generation)
+            return INVALID_COMPONENT_TYPE;
+
+        return component_records[id.index].type;
+    }
+
+    void ComponentManager::remove_entity(EntityID owner_id)
+    {
+        // The index may be reused by an entity that starts out active
+        if (owner_id.index < entity_inactive.size())
+            entity_inactive[owner_id.index] = 0;
+
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return;
+
+        uint32_t archetype_index = location->archetype;
+        uint32_t row = location->row;
+        Archetype &archetype = *archetypes[archetype_index];
+
+        for (size_t column = 0; column < archetype.get_column_count(); column++)
+        {
+            Component *component = archetype.get_column(column).get(row);
+
+            component_destroyed.invoke(component->get_handle());
+            release_id(component->get_id());
+        }
+
+        remove_row(archetype_index, row);
+        clear_location(owner_id);
+    }
+
+    void ComponentManager::setup_entity(EntityID owner_id)
+    {
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return;
+
+        Archetype &archetype = *archetypes[location->archetype];
+        for (size_t column = 0; column < archetype.get_column_count(); column++)
+        {
+            Component *component = archetype.get_column(column).get(location->row);
+            if (component->is_enabled())
+                component->setup();
+        }
+    }
+
+    void ComponentManager::update_entity(EntityID owner_id, float delta_time)
+    {
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return;
+
+        Archetype &archetype = *archetypes[location->archetype];
+        for (size_t column = 0; column < archetype.get_column_count(); column++)
+        {
+            Component *component = archetype.get_column(column).get(location->row);
+            if (component->is_enabled())
+                component->update(delta_time);
+        }
+    }
+
+    void ComponentManager::update_components(float delta_time)
+    {
+        const ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+        for (ComponentTypeID type_id : registry.get_update_types())
+        {
+            if (type_id >= component_pools.size())
+                continue;
+
+            for (const PoolEntry &entry : component_pools[type_id])
+            {
+                Archetype &archetype = *archetypes[entry.archetype];
+                registry.update_column(type_id, archetype.get_column(entry.column), archetype.get_active_count(), delta_time);
+            }
+        }
     }
 
     ComponentID ComponentManager::allocate_id()
@@ -49,22 +550,359 @@ namespace Engine
         {
             index = static_cast<uint32_t>(generations.size());
             generations.push_back(0);
+            component_records.emplace_back();
         }
 
         return {index, generations[index]};
     }
 
+    void ComponentManager::release_id(ComponentID id)
+    {
+        component_records[id.index] = {};
+
+        free_indices.push_back(id.index);
+        generations[id.index]++;
+    }
+
+    const ComponentManager::EntityLocation *ComponentManager::find_location(EntityID owner_id) const
+    {
+        if (owner_id.index >= entity_locations.size())
+            return nullptr;
+
+        const EntityLocation &location = entity_locations[owner_id.index];
+        if (location.archetype == INVALID_ARCHETYPE)
+            return nullptr;
+
+        // A stale ID can share the index with the entity currently stored there
+        if (archetypes[location.archetype]->get_entities()[location.row] != owner_id)
+            return nullptr;
+
+        return &location;
+    }
+
+    uint32_t ComponentManager::get_or_create_archetype(const ComponentSignature &signature)
+    {
+        auto it = archetype_lookup.find(signature);
+        if (it != archetype_lookup.end())
+            return it->second;
+
+        std::vector<ComponentTypeID> types;
+        for (ComponentTypeID type_id = 0; type_id < MAX_COMPONENT_TYPES; type_id++)
+        {
+            if (signature.test(type_id))
+                types.push_back(type_id);
+        }
+
+        uint32_t archetype_index = static_cast<uint32_t>(archetypes.size());
+
+        archetypes.push_back(std::make_unique<Archetype>(types));
+
+        for (uint32_t column = 0; column < types.size(); column++)
+        {
+            ComponentTypeID type_id = types[column];
+            if (type_id >= component_pools.size())
+                component_pools.resize(type_id + 1);
+
+            component_pools[type_id].push_back({archetype_index, column});
+        }
+
+        archetype_lookup.emplace(signature, archetype_index);
+
+        for (auto &[required, matches] : query_cache)
+        {
+            if (archetypes[archetype_index]->matches(required))
+                matches.push_back(archetype_index);
+        }
+
+        return archetype_index;
+    }
+
+    void ComponentManager::set_location(EntityID owner_id, uint32_t archetype_index, uint32_t row)
+    {
+        if (owner_id.index >= entity_locations.size())
+        {
+            entity_locations.resize(owner_id.index + 1);
+            entity_signatures.resize(owner_id.index + 1);
+        }
+
+        entity_locations[owner_id.index] = {archetype_index, row};
+        entity_signatures[owner_id.index] = archetypes[archetype_index]->get_signature();
+
+        // New rows are appended behind the inactive range, active entities move to the front
+        Archetype &archetype = *archetypes[archetype_index];
+        if (is_entity_active(owner_id) && row >= archetype.get_active_count())
+        {
+            entity_locations[owner_id.index].row = static_cast<uint32_t>(archetype.activate_row(row));
+            refresh_row(archetype_index, row);
+        }
+    }
+
+    void ComponentManager::refresh_row(uint32_t archetype_index, size_t row)
+    {
+        const Archetype &archetype = *archetypes[archetype_index];
+        if (row < archetype.size())
+            entity_locations[archetype.get_entities()[row].index].row = static_cast<uint32_t>(row);
+    }
+
+    void ComponentManager::set_entity_active(EntityID owner_id, bool active)
+    {
+        if (owner_id.index >= entity_inactive.size())
+            entity_inactive.resize(owner_id.index + 1, 0);
+
+        entity_inactive[owner_id.index] = active ? 0 : 1;
+
+        const EntityLocation *location = find_location(owner_id);
+        if (!location)
+            return;
+
+        uint32_t archetype_index = location->archetype;
+        size_t row = location->row;
+        Archetype &archetype = *archetypes[archetype_index];
+
+        bool row_active = row < archetype.get_active_count();
+        if (row_active == active)
+            return;
+
+        size_t target = active ? archetype.activate_row(row) : archetype.deactivate_row(row);
+
+        refresh_row(archetype_index, row);
+        refresh_row(archetype_index, target);
+    }
+
+    void ComponentManager::clear_location(EntityID owner_id)
+    {
+        entity_locations[owner_id.index] = {};
+        entity_signatures[owner_id.index].reset();
+    }
+
+    Component *ComponentManager::attach_component(EntityID owner_id, ComponentTypeID type_id, Component *source)
+    {
+        const EntityLocation *source_location = find_location(owner_id);
+        EntityLocation previous = source_location ? *source_location : EntityLocation{};
+
+        Archetype *source_archetype = source_location ? archetypes[previous.archetype].get() : nullptr;
+
+        ComponentSignature signature;
+        if (source_archetype)
+        {
+            if (source_archetype->has_type(type_id))
+            {
+                throw std::runtime_error("Entity already has a component of type " +
+                                         ComponentRegistry::get_instance().get_type_name(type_id));
+            }
+
+            signature = source_archetype->get_signature();
+        }
+
+        signature.set(type_id);
+
+        uint32_t target_index = get_or_create_archetype(signature);
+        Archetype &target = *archetypes[target_index];
+
+        uint32_t target_row = static_cast<uint32_t>(target.push_entity(owner_id));
+        Component *attached = nullptr;
+
+        for (size_t column = 0; column < target.get_column_count(); column++)
+        {
+            ComponentColumnBase &target_column = target.get_column(column);
+            ComponentTypeID column_type = target.get_types()[column];
+
+            if (column_type == type_id)
+            {
+                attached = source ? target_column.push_moved(*source, current_tick) : target_column.emplace_default(current_tick);
+                attached->type_id = type_id;
+                continue;
+            }
+
+            ComponentColumnBase &source_column = source_archetype->get_column(source_archetype->get_column_index(column_type));
+            target_column.push_moved_from(source_column, previous.row);
+        }
+
+        if (source_archetype)
+            remove_row(previous.archetype, previous.row);
+
+        set_location(owner_id, target_index, target_row);
+
+        return attached;
+    }
+
+    void ComponentManager::detach_component(EntityID owner_id, ComponentTypeID type_id)
+    {
+        const EntityLocation *source_location = find_location(owner_id);
+        if (!source_location)
+            return;
+
+        EntityLocation previous = *source_location;
+        Archetype &source_archetype = *archetypes[previous.archetype];
+
+        ComponentSignature signature = source_archetype.get_signature();
+        signature.reset(type_id);
+
+        if (signature.none())
+        {
+            remove_row(previous.archetype, previous.row);
+            clear_location(owner_id);
+            return;
+        }
+
+        uint32_t target_index = get_or_create_archetype(signature);
+        Archetype &target = *archetypes[target_index];
+
+        uint32_t target_row = static_cast<uint32_t>(target.push_entity(owner_id));
+
+        for (size_t column = 0; column < target.get_column_count(); column++)
+        {
+            ComponentTypeID column_type = target.get_types()[column];
+            ComponentColumnBase &source_column = source_archetype.get_column(source_archetype.get_column_index(column_type));
+
+            target.get_column(column).push_moved_from(source_column, previous.row);
+        }
+
+        remove_row(previous.archetype, previous.row);
+        set_location(owner_id, target_index, target_row);
+    }
+
+    void ComponentManager::remove_row(uint32_t archetype_index, uint32_t row)
+    {
+        Archetype &archetype = *archetypes[archetype_index];
+        size_t active_count = archetype.get_active_count();
+
+        archetype.swap_remove(row);
+
+        refresh_row(archetype_index, row);
+        if (row < active_count)
+            refresh_row(archetype_index, active_count - 1);
+    }
+
     void ComponentManager::resolve_references()
     {
     }
 
+    void ComponentManager::capture(Snapshot &snapshot) const
+    {
+        snapshot.archetypes.resize(archetypes.size());
+
+        for (size_t i = 0; i < archetypes.size(); i++)
+        {
+            // Slots keep their archetype copies between captures, so steady state copies without allocating
+            std::unique_ptr<Archetype> &copy = snapshot.archetypes[i];
+            if (!copy || copy->get_signature() != archetypes[i]->get_signature())
+                copy = std::make_unique<Archetype>(archetypes[i]->get_types());
+
+            copy->assign(*archetypes[i]);
+        }
+
+        snapshot.entity_locations = entity_locations;
+        snapshot.entity_signatures = entity_signatures;
+        snapshot.entity_inactive = entity_inactive;
+
+        snapshot.component_records = component_records;
+        snapshot.generations = generations;
+        snapshot.free_indices = free_indices;
+    }
+
+    void ComponentManager::restore(const Snapshot &snapshot)
+    {
+        if (snapshot.archetypes.size() > archetypes.size())
+            throw std::runtime_error("Snapshot does not match the archetype layout of this ComponentManager!");
+
+        for (size_t i = 0; i < snapshot.archetypes.size(); i++)
+        {
+            if (snapshot.archetypes[i]->get_signature() != archetypes[i]->get_signature())
+                throw std::runtime_error("Snapshot does not match the archetype layout of this ComponentManager!");
+        }
+
+        // Subscribers are not part of the snapshot, detach them from the rows they are in now
+        std::unordered_map<size_t, EngineObject::Subscribers> subscribers;
+        for (auto &archetype : archetypes)
+        {
+            for (size_t column = 0; column < archetype->get_column_count(); column++)
+            {
+                ComponentColumnBase &components = archetype->get_column(column);
+                for (size_t row = 0; row < archetype->size(); row++)
+                {
+                    Component *component = components.get(row);
+                    if (component->has_subscribers())
+                        subscribers.emplace(component->get_instance_id(), component->take_subscribers());
+                }
+            }
+        }
+
+        for (size_t i = 0; i < archetypes.size(); i++)
+        {
+            if (i < snapshot.archetypes.size())
+                archetypes[i]->assign(*snapshot.archetypes[i]);
+            else
+                archetypes[i]->clear();
+        }
+
+        // and hand them to the restored component with the same instance ID
+        for (auto &archetype : archetypes)
+        {
+            if (subscribers.empty())
+                break;
+
+            for (size_t column = 0; column < archetype->get_column_count(); column++)
+            {
+                ComponentColumnBase &components = archetype->get_column(column);
+                for (size_t row = 0; row < archetype->size(); row++)
+                {
+                    Component *component = components.get(row);
+                    auto it = subscribers.find(component->get_instance_id());
+                    if (it == subscribers.end())
+                        continue;
+
+                    component->set_subscribers(std::move(it->second));
+                    subscribers.erase(it);
+                }
+            }
+        }
+
+        entity_locations = snapshot.entity_locations;
+        entity_signatures = snapshot.entity_signatures;
+        entity_inactive = snapshot.entity_inactive;
+
+        component_records = snapshot.component_records;
+        generations = snapshot.generations;
+        free_indices = snapshot.free_indices;
+    }
+
+    size_t ComponentManager::Snapshot::get_byte_size() const
+    {
+        size_t bytes = 0;
+        for (const auto &archetype : archetypes)
+            bytes += archetype->get_byte_size();
+
+        bytes += entity_locations.size() * sizeof(EntityLocation);
+        bytes += entity_signatures.size() * sizeof(ComponentSignature);
+        bytes += entity_inactive.size() * sizeof(uint8_t);
+        bytes += component_records.size() * sizeof(ComponentRecord);
+        bytes += (generations.size() + free_indices.size()) * sizeof(uint32_t);
+
+        return bytes;
+    }
+
     void ComponentManager::serialize(Serialization::SerializationContext &ctx) const
     {
+        const ComponentRegistry &registry = ComponentRegistry::get_instance();
+
         ctx.begin_array_key("components");
 
-        for (const auto &[id, component_ptr] : component_list)
+        for (const auto &archetype : archetypes)
         {
-            component_ptr->serialize(ctx);
+            for (size_t column = 0; column < archetype->get_column_count(); column++)
+            {
+                const std::string &type_name = registry.get_type_name(archetype->get_types()[column]);
+                ComponentColumnBase &components = archetype->get_column(column);
+
+                for (size_t row = 0; row < components.size(); row++)
+                {
+                    ctx.begin_object_push();
+                    ctx.write("type", type_name);
+                    components.get(row)->serialize(ctx);
+                    ctx.end_object();
+                }
+            }
         }
 
         ctx.end_array();
@@ -72,10 +910,24 @@ namespace Engine
 
     void ComponentManager::deserialize(Serialization::SerializationContext &ctx)
     {
-        component_list.clear();
+        archetypes.clear();
+        archetype_lookup.clear();
+        component_pools.clear();
+
+        // Keep the cached lists alive, views may still point at them
+        for (auto &[required, matches] : query_cache)
+            matches.clear();
+
+        entity_locations.clear();
+        entity_signatures.clear();
+        entity_inactive.clear();
+        component_records.clear();
         generations.clear();
         free_indices.clear();
 
+        ComponentRegistry &registry = ComponentRegistry::get_instance();
+        EntityManager &entity_manager = stage->get_entity_manager();
+
         ctx.begin_array_key("components");
 
         for (int i = 0; i < ctx.size(); i++)
@@ -84,15 +936,39 @@ namespace Engine
 
             std::string component_type = ctx.read<std::string>("type");
 
-            std::shared_ptr<Component> component = ComponentRegistry::get_instance().instantiate_raw(component_type);
+            std::unique_ptr<Component> component = registry.instantiate_raw(component_type);
             if (!component)
                 throw std::runtime_error("Unknown component type: " + component_type);
 
             component->deserialize(ctx);
 
+            ComponentID id = component->get_id();
+            EntityID owner_id = component->get_owner_id();
+            ComponentTypeID type_id = registry.get_type_id(component_type);
+
+            if (!entity_manager.has_entity(owner_id))
+                throw std::runtime_error("Component " + component_type + " references a missing entity");
+
+            Component *stored = attach_component(owner_id, type_id, component.get());
+            stored->set_owner(&entity_manager, owner_id);
+
+            if (id.index >= generations.size())
+            {
+                generations.resize(id.index + 1, 0);
+                component_records.resize(id.index + 1);
+            }
+            generations[id.index] = id.generation;
+            component_records[id.index] = {owner_id, type_id};
+
             ctx.end_object();
         }
 
         ctx.end_array();
+
+        for (uint32_t index = 0; index < component_records.size(); index++)
+        {
+            if (!component_records[index].owner.is_valid())
+                free_indices.push_back(index);
+        }
     }
 }
@@ -4,7 +4,7 @@
 
 namespace Engine
 {
-    std::shared_ptr<Component> ComponentRegistry::instantiate_raw(const std::string &name) const
+    std::unique_ptr<Component> ComponentRegistry::instantiate_raw(const std::string &name) const
     {
         auto it = creators.find(name);
         if (it != creators.end())
@@ -15,18 +15,28 @@ namespace Engine
         throw std::runtime_error("Could not find Component with type: " + name);
     }
 
+    ComponentTypeID ComponentRegistry::get_type_id(const std::string &name) const
+    {
+        auto it = name_ids.find(name);
+        if (it == name_ids.end())
+            return INVALID_COMPONENT_TYPE;
+
+        return it->second;
+    }
+
+    std::unique_ptr<ComponentColumnBase> ComponentRegistry::create_column(ComponentTypeID type_id) const
+    {
+        if (type_id >= type_infos.size())
+            throw std::runtime_error("Cannot create column for unregistered component type id " + std::to_string(type_id));
+
+        return type_infos[type_id].create_column();
+    }
+
     std::string ComponentRegistry::get_name(const Component *component) const
     {
-        if (!component)
+        if (!component || component->get_type_id() >= type_infos.size())
             return {};
 
-        std::type_index type_id(typeid(*component));
-
-        auto it = type_names.find(type_id);
-        if (it != type_names.end())
-        {
-            return it->second;
-        }
-        return {};
+        return type_infos[component->get_type_id()].name;
     }
 }
@@ -0,0 +1,23 @@
+#include "engine/data/string_table.h"
+
+namespace Engine
+{
+    StringID StringTable::intern(std::string_view text)
+    {
+        auto it = ids.find(text);
+        if (it != ids.end())
+            return it->second;
+
+        StringID id = static_cast<StringID>(strings.size());
+        const std::string &stored = strings.emplace_back(text);
+
+        ids.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    StringID StringTable::find(std::string_view text) const
+    {
+        auto it = ids.find(text);
+        return it != ids.end() ? it->second : INVALID_STRING;
+    }
+}
@@ -1,16 +1,27 @@
 ﻿#include "engine/entity/entity.h"
 #include "engine/entity/entity_manager.h"
 #include "engine/component/component.h"
+#include "engine/component/component_manager.h"
+#include "engine/stage/stage.h"
 
 #include <cassert>
 
 namespace Engine
 {
-    Entity::Entity(std::string name) : name(std::move(name)), components() {}
+    Entity::Entity(StringID name_id) : name_id(name_id) {}
 
-    std::string Entity::get_name() const
+    const std::string &Entity::get_name() const
     {
-        return name;
+        assert(entity_manager && "Entity has no assigned EntityManager");
+
+        return entity_manager->get_name_table().get(name_id);
+    }
+
+    void Entity::set_name(std::string_view name)
+    {
+        assert(entity_manager && "Entity has no assigned EntityManager");
+
+        entity_manager->rename_entity(id, name);
     }
 
     EntityID Entity::get_id() const
@@ -43,27 +54,38 @@ namespace Engine
         return children;
     }
 
-    void Entity::set_parent(const EntityID &parent_id)
+    bool Entity::set_parent(const EntityID &parent_id)
+    {
+        assert(entity_manager && "Entity has no assigned EntityManager");
+
+        return entity_manager->set_parent(id, parent_id);
+    }
+
+    void Entity::set_enabled(bool enabled)
+    {
+        assert(entity_manager && "Entity has no assigned EntityManager");
+
+        entity_manager->set_enabled(id, enabled);
+    }
+
+    ComponentManager *Entity::get_component_manager() const
     {
-        this->parent_id = parent_id;
+        if (!entity_manager || !entity_manager->get_stage())
+            return nullptr;
+
+        return &entity_manager->get_stage()->get_component_manager();
     }
 
     void Entity::update(float delta_time)
     {
-        for (auto &component : components)
-        {
-            assert(component && "Component reference is not valid.");
-            component->update(delta_time);
-        }
+        if (ComponentManager *component_manager = get_component_manager())
+            component_manager->update_entity(id, delta_time);
     }
 
     void Entity::setup()
     {
-        for (auto &component : components)
-        {
-            assert(component && "Component reference is not valid.");
-            component->setup();
-        }
+        if (ComponentManager *component_manager = get_component_manager())
+            component_manager->setup_entity(id);
     }
 
     // Serialization
@@ -73,7 +95,17 @@ namespace Engine
         id.serialize(ctx);
         ctx.end_object();
 
-        ctx.write("name", name);
+        ctx.write("name", get_name());
+
+        if (!enabled)
+            ctx.write("enabled", false);
+
+        if (parent_id.is_valid())
+        {
+            ctx.begin_object_key("parent");
+            parent_id.serialize(ctx);
+            ctx.end_object();
+        }
     }
 
     void Entity::deserialize(Serialization::SerializationContext &ctx)
@@ -82,6 +114,20 @@ namespace Engine
         id.deserialize(ctx);
         ctx.end_object();
 
-        name = ctx.read<std::string>("name");
+        assert(entity_manager && "Entity has no assigned EntityManager");
+        name_id = entity_manager->get_name_table().intern(ctx.read<std::string>("name"));
+
+        enabled = !ctx.has_key("enabled") || ctx.read<bool>("enabled");
+        active = true;
+
+        parent_id = EntityID::Invalid;
+        children_ids.clear();
+
+        if (ctx.has_object("parent"))
+        {
+            ctx.begin_object_key("parent");
+            parent_id.deserialize(ctx);
+            ctx.end_object();
+        }
     }
 }
@@ -0,0 +1,61 @@
+#include "engine/entity/entity_hierarchy.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+
+namespace Engine
+{
+    uint32_t EntityHierarchy::get_position(const EntityID &id) const
+    {
+        if (id.index >= positions.size())
+            return NO_PARENT;
+
+        uint32_t position = positions[id.index];
+        if (position == NO_PARENT || order[position] != id)
+            return NO_PARENT;
+
+        return position;
+    }
+
+    void EntityHierarchy::rebuild(const EntityManager &manager)
+    {
+        const std::vector<Entity> &entities = manager.get_entities();
+
+        order.clear();
+        parent_indices.clear();
+        depths.clear();
+
+        order.reserve(entities.size());
+        parent_indices.reserve(entities.size());
+        depths.reserve(entities.size());
+
+        uint32_t max_index = 0;
+        for (const Entity &entity : entities)
+        {
+            if (entity.id.index + 1 > max_index)
+                max_index = entity.id.index + 1;
+
+            if (!manager.has_entity(entity.parent_id))
+            {
+                order.push_back(entity.id);
+                parent_indices.push_back(NO_PARENT);
+                depths.push_back(0);
+            }
+        }
+
+        positions.assign(max_index, NO_PARENT);
+
+        // The order doubles as the breadth-first queue
+        for (size_t head = 0; head < order.size(); head++)
+        {
+            positions[order[head].index] = static_cast<uint32_t>(head);
+
+            const Entity *entity = manager.get_entity_by_id(order[head]);
+            for (const EntityID &child : entity->children_ids)
+            {
+                order.push_back(child);
+                parent_indices.push_back(static_cast<uint32_t>(head));
+                depths.push_back(depths[head] + 1);
+            }
+        }
+    }
+}
@@ -2,8 +2,13 @@
 #include "engine/entity/entity_id.h"
 #include "engine/entity/entity.h"
 #include "engine/component/component.h"
+#include "engine/component/component_manager.h"
+#include "engine/stage/prefab.h"
+#include "engine/stage/stage.h"
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace Engine
 {
@@ -14,46 +19,211 @@ namespace Engine
         Logger::log_info("[EntityManager] Initialization complete");
     }
 
-    Entity *EntityManager::create_entity(std::string name)
-    {
-        assert(generations.size() == entity_list.size() && "entity_list size and generations size do not match.");
-
-        uint32_t index;
+    EntityManager::~EntityManager() = default;
 
+    uint32_t EntityManager::allocate_index()
+    {
         if (!free_indices.empty())
         {
-            index = free_indices.back();
+            uint32_t index = free_indices.back();
             free_indices.pop_back();
+            return index;
         }
-        else
+
+        uint32_t index = static_cast<uint32_t>(generations.size());
+        generations.push_back(0);
+        slots.push_back(INVALID_SLOT);
+
+        return index;
+    }
+
+    Entity *EntityManager::create_entity(std::string_view name)
+    {
+        assert(generations.size() == slots.size() && "slots size and generations size do not match.");
+
+        uint32_t index = allocate_index();
+        EntityID id = {index, generations[index]};
+
+        slots[index] = static_cast<uint32_t>(entities.size());
+
+        StringID name_id = name_table.intern(name);
+
+        Entity &entity = entities.emplace_back(name_id);
+        entity.set_manager(this);
+        entity.id = id;
+
+        index_name(id, name_id);
+
+        // New entities are active, move it in front of any inactive ones
+        swap_entities(slots[index], static_cast<uint32_t>(active_count++));
+
+        hierarchy_dirty = true;
+
+        return &entities[slots[index]];
+    }
+
+    void EntityManager::create_entities(size_t count, const ComponentSignature &components, std::vector<EntityID> &out_ids,
+                                        std::string_view name)
+    {
+        if (count == 0)
+            return;
+
+        size_t first = out_ids.size();
+        size_t fresh = count > free_indices.size() ? count - free_indices.size() : 0;
+
+        out_ids.reserve(first + count);
+        entities.reserve(entities.size() + count);
+        generations.reserve(generations.size() + fresh);
+        slots.reserve(slots.size() + fresh);
+
+        StringID name_id = name_table.intern(name);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t index = allocate_index();
+            EntityID id = {index, generations[index]};
+
+            slots[index] = static_cast<uint32_t>(entities.size());
+
+            Entity &entity = entities.emplace_back(name_id);
+            entity.set_manager(this);
+            entity.id = id;
+
+            index_name(id, name_id);
+
+            swap_entities(slots[index], static_cast<uint32_t>(active_count++));
+
+            out_ids.push_back(id);
+        }
+
+        hierarchy_dirty = true;
+
+        if (stage && components.any())
+            stage->get_component_manager().create_components(out_ids.data() + first, count, components);
+    }
+
+    void EntityManager::instantiate(const Prefab &prefab, size_t count, std::vector<EntityID> &out_roots)
+    {
+        size_t entity_count = prefab.get_entity_count();
+        if (count == 0 || entity_count == 0)
+            return;
+
+        std::vector<StringID> name_ids;
+        name_ids.reserve(entity_count);
+        for (const Prefab::PrefabEntity &baked : prefab.entities)
+            name_ids.push_back(name_table.intern(baked.name));
+
+        std::vector<EntityID> ids;
+        ids.reserve(count * entity_count);
+        out_roots.reserve(out_roots.size() + count);
+        entities.reserve(entities.size() + count * entity_count);
+
+        for (size_t instance = 0; instance < count; instance++)
         {
-            index = static_cast<uint32_t>(generations.size());
-            generations.push_back(0);
+            const EntityID *instance_ids = ids.data() + instance * entity_count;
+
+            for (size_t i = 0; i < entity_count; i++)
+            {
+                uint32_t index = allocate_index();
+                EntityID id = {index, generations[index]};
+
+                slots[index] = static_cast<uint32_t>(entities.size());
+
+                Entity &entity = entities.emplace_back(name_ids[i]);
+                entity.set_manager(this);
+                entity.id = id;
+                entity.enabled = prefab.entities[i].enabled;
+
+                // Parents come first in the prefab, so they already exist
+                uint32_t parent = prefab.entities[i].parent;
+                if (parent != Prefab::NO_PARENT)
+                {
+                    entity.parent_id = instance_ids[parent];
+                    entities[slots[instance_ids[parent].index]].children_ids.push_back(id);
+                }
+
+                index_name(id, name_ids[i]);
+                swap_entities(slots[index], static_cast<uint32_t>(active_count++));
+
+                ids.push_back(id);
+            }
+
+            out_roots.push_back(instance_ids[0]);
         }
 
-        EntityID id = {index, generations[index]};
+        hierarchy_dirty = true;
+        hierarchy_version++;
+
+        if (stage)
+            stage->get_component_manager().instantiate_components(prefab, ids.data(), count);
 
-        auto entity_ptr = std::make_unique<Entity>(name);
-        entity_ptr->set_manager(this);
-        entity_ptr->id = id;
+        if (!prefab.has_disabled)
+            return;
 
-        Entity *raw_ptr = entity_ptr.get();
-        entity_list.emplace(id, std::move(entity_ptr));
+        // Everything was created active, settle disabled entities and their subtrees top-down
+        for (const EntityID &id : ids)
+        {
+            const Entity *entity = get_entity_by_id(id);
+            const Entity *parent = get_entity_by_id(entity->parent_id);
 
-        return raw_ptr;
+            if (!entity->enabled || (parent && !parent->active))
+                set_active(id, false);
+        }
     }
 
     void EntityManager::destroy_entity(const EntityID &id)
     {
-        auto it = entity_list.find(id);
+        Entity *entity = get_entity_by_id(id);
+        if (!entity)
+            return;
+
+        std::vector<EntityID> descendants;
+        collect_descendants(id, descendants);
+
+        if (Entity *parent = get_entity_by_id(entity->parent_id))
+        {
+            std::vector<EntityID> &siblings = parent->children_ids;
+            siblings.erase(std::find(siblings.begin(), siblings.end(), id));
+        }
+
+        for (const EntityID &descendant : descendants)
+            release_entity(descendant);
+
+        release_entity(id);
+
+        hierarchy_dirty = true;
+    }
+
+    void EntityManager::release_entity(const EntityID &id)
+    {
+        if (stage)
+            stage->get_component_manager().remove_entity(id);
 
-        if (it != entity_list.end())
+        uint32_t slot = slots[id.index];
+        unindex_name(id, entities[slot].name_id);
+
+        // Close the hole inside the active range first
+        if (slot < active_count)
         {
-            entity_list.erase(it);
+            active_count--;
+            swap_entities(slot, static_cast<uint32_t>(active_count));
+            slot = static_cast<uint32_t>(active_count);
+        }
 
-            generations[id.index]++;
-            free_indices.push_back(id.index);
+        uint32_t last_slot = static_cast<uint32_t>(entities.size() - 1);
+
+        // Keep the dense array packed by moving the last entity into the freed slot
+        if (slot != last_slot)
+        {
+            entities[slot] = std::move(entities[last_slot]);
+            slots[entities[slot].id.index] = slot;
         }
+
+        entities.pop_back();
+
+        slots[id.index] = INVALID_SLOT;
+        generations[id.index]++;
+        free_indices.push_back(id.index);
     }
 
     void EntityManager::destroy_entity(const Entity &entity)
@@ -61,10 +231,296 @@ namespace Engine
         destroy_entity(entity.get_id());
     }
 
+    bool EntityManager::set_parent(const EntityID &child, const EntityID &parent)
+    {
+        Entity *child_entity = get_entity_by_id(child);
+        if (!child_entity)
+            return false;
+
+        if (child_entity->parent_id == parent)
+            return true;
+
+        if (parent.is_valid())
+        {
+            // Walk up from the new parent; meeting the child there would close a cycle
+            for (Entity *ancestor = get_entity_by_id(parent); ancestor; ancestor = get_entity_by_id(ancestor->parent_id))
+            {
+                if (ancestor->id == child)
+                    return false;
+            }
+
+            if (!has_entity(parent))
+                return false;
+        }
+
+        if (Entity *old_parent = get_entity_by_id(child_entity->parent_id))
+        {
+            std::vector<EntityID> &siblings = old_parent->children_ids;
+            siblings.erase(std::find(siblings.begin(), siblings.end(), child));
+        }
+
+        child_entity->parent_id = parent;
+
+        if (Entity *new_parent = get_entity_by_id(parent))
+            new_parent->children_ids.push_back(child);
+
+        hierarchy_dirty = true;
+        hierarchy_version++;
+
+        propagate_active(child);
+
+        return true;
+    }
+
+    void EntityManager::collect_descendants(const EntityID &root, std::vector<EntityID> &out) const
+    {
+        const Entity *entity = get_entity_by_id(root);
+        if (!entity)
+            return;
+
+        // The output doubles as the breadth-first queue
+        size_t head = out.size();
+        out.insert(out.end(), entity->children_ids.begin(), entity->children_ids.end());
+
+        for (; head < out.size(); head++)
+        {
+            const Entity *child = get_entity_by_id(out[head]);
+            out.insert(out.end(), child->children_ids.begin(), child->children_ids.end());
+        }
+    }
+
+    void EntityManager::set_enabled(const EntityID &id, bool enabled)
+    {
+        Entity *entity = get_entity_by_id(id);
+        if (!entity || entity->enabled == enabled)
+            return;
+
+        entity->enabled = enabled;
+        propagate_active(id);
+    }
+
+    void EntityManager::propagate_active(EntityID root)
+    {
+        auto expected_state = [this](const Entity &entity)
+        {
+            const Entity *parent = get_entity_by_id(entity.parent_id);
+            return entity.enabled && (!parent || parent->active);
+        };
+
+        Entity *entity = get_entity_by_id(root);
+
+        bool active = expected_state(*entity);
+        if (entity->active == active)
+            return;
+
+        bool has_children = !entity->children_ids.empty();
+        set_active(root, active);
+
+        if (!has_children)
+            return;
+
+        // Breadth-first, so every parent is settled before its children are looked at
+        std::vector<EntityID> descendants;
+        collect_descendants(root, descendants);
+
+        for (const EntityID &descendant : descendants)
+        {
+            Entity *child = get_entity_by_id(descendant);
+
+            bool child_active = expected_state(*child);
+            if (child->active != child_active)
+                set_active(descendant, child_active);
+        }
+    }
+
+    void EntityManager::refresh_active_states()
+    {
+        const std::vector<EntityID> &order = get_hierarchy().get_order();
+
+        for (const EntityID &id : order)
+        {
+            Entity *entity = get_entity_by_id(id);
+            const Entity *parent = get_entity_by_id(entity->parent_id);
+
+            bool active = entity->enabled && (!parent || parent->active);
+            if (entity->active != active)
+                set_active(id, active);
+        }
+    }
+
+    void EntityManager::rename_entity(const EntityID &id, std::string_view name)
+    {
+        Entity *entity = get_entity_by_id(id);
+        if (!entity)
+            return;
+
+        StringID name_id = name_table.intern(name);
+        if (entity->name_id == name_id)
+            return;
+
+        unindex_name(id, entity->name_id);
+        entity->name_id = name_id;
+        index_name(id, name_id);
+    }
+
+    const std::vector<EntityID> &EntityManager::find_entities(std::string_view name) const
+    {
+        static const std::vector<EntityID> none;
+
+        StringID name_id = name_table.find(name);
+        if (name_id == StringTable::INVALID_STRING || name_id >= name_index.size())
+            return none;
+
+        return name_index[name_id];
+    }
+
+    Entity *EntityManager::find_entity(std::string_view name) const
+    {
+        const std::vector<EntityID> &matches = find_entities(name);
+        return matches.empty() ? nullptr : get_entity_by_id(matches.front());
+    }
+
+    Entity *EntityManager::find_entity_by_path(std::string_view path) const
+    {
+        // Names of every segment, leaf first. A name that was never interned cannot match
+        std::vector<StringID> segments;
+        while (true)
+        {
+            size_t separator = path.rfind('/');
+            std::string_view segment = separator == std::string_view::npos ? path : path.substr(separator + 1);
+
+            StringID name_id = name_table.find(segment);
+            if (segment.empty() || name_id == StringTable::INVALID_STRING)
+                return nullptr;
+
+            segments.push_back(name_id);
+
+            if (separator == std::string_view::npos)
+                break;
+
+            path = path.substr(0, separator);
+        }
+
+        if (segments.front() >= name_index.size())
+            return nullptr;
+
+        for (const EntityID &candidate : name_index[segments.front()])
+        {
+            Entity *entity = get_entity_by_id(candidate);
+            const Entity *current = entity;
+
+            size_t depth = 1;
+            while (depth < segments.size())
+            {
+                current = get_entity_by_id(current->parent_id);
+                if (!current || current->name_id != segments[depth])
+                    break;
+
+                depth++;
+            }
+
+            // The top segment has to be a root
+            if (depth == segments.size() && !has_entity(current->parent_id))
+                return entity;
+        }
+
+        return nullptr;
+    }
+
+    std::string EntityManager::get_path(const EntityID &id) const
+    {
+        std::vector<StringID> names;
+        for (const Entity *entity = get_entity_by_id(id); entity; entity = get_entity_by_id(entity->parent_id))
+            names.push_back(entity->name_id);
+
+        std::string path;
+        for (auto it = names.rbegin(); it != names.rend(); ++it)
+        {
+            if (!path.empty())
+                path += '/';
+
+            path += name_table.get(*it);
+        }
+
+        return path;
+    }
+
+    void EntityManager::index_name(const EntityID &id, StringID name_id)
+    {
+        if (name_id >= name_index.size())
+            name_index.resize(name_id + 1);
+
+        name_index[name_id].push_back(id);
+    }
+
+    void EntityManager::unindex_name(const EntityID &id, StringID name_id)
+    {
+        std::vector<EntityID> &bucket = name_index[name_id];
+
+        auto it = std::find(bucket.begin(), bucket.end(), id);
+        if (it == bucket.end())
+            return;
+
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+
+    void EntityManager::set_active(EntityID id, bool active)
+    {
+        uint32_t slot = slots[id.index];
+
+        if (active)
+            swap_entities(slot, static_cast<uint32_t>(active_count++));
+        else
+            swap_entities(slot, static_cast<uint32_t>(--active_count));
+
+        entities[slots[id.index]].active = active;
+
+        if (stage)
+            stage->get_component_manager().set_entity_active(id, active);
+    }
+
+    void EntityManager::swap_entities(uint32_t a, uint32_t b)
+    {
+        if (a == b)
+            return;
+
+        std::swap(entities[a], entities[b]);
+
+        slots[entities[a].id.index] = a;
+        slots[entities[b].id.index] = b;
+    }
+
+    const EntityHierarchy &EntityManager::get_hierarchy()
+    {
+        if (hierarchy_dirty)
+        {
+            hierarchy.rebuild(*this);
+            hierarchy_dirty = false;
+        }
+
+        return hierarchy;
+    }
+
+    void EntityManager::record_transform_change(const EntityID &id)
+    {
+        std::lock_guard<std::mutex> lock(transform_changes_mutex);
+        transform_changes.push_back(id);
+    }
+
+    void EntityManager::take_transform_changes(std::vector<EntityID> &out)
+    {
+        std::lock_guard<std::mutex> lock(transform_changes_mutex);
+
+        out.insert(out.end(), transform_changes.begin(), transform_changes.end());
+        transform_changes.clear();
+    }
+
     bool EntityManager::has_entity(const EntityID &id) const
     {
-        auto it = entity_list.find(id);
-        return it != entity_list.end();
+        return id.index < slots.size() &&
+               slots[id.index] != INVALID_SLOT &&
+               generations[id.index] == id.generation;
     }
 
     bool EntityManager::has_entity(const Entity &entity) const
@@ -74,38 +530,83 @@ namespace Engine
 
     Entity *EntityManager::get_entity_by_id(const EntityID &id) const
     {
-        auto found_entity = entity_list.find(id);
-        if (found_entity != entity_list.end())
-            return found_entity->second.get();
+        if (!has_entity(id))
+            return nullptr;
 
-        return nullptr;
+        return const_cast<Entity *>(&entities[slots[id.index]]);
+    }
+
+    size_t EntityManager::get_entity_count() const
+    {
+        return entities.size();
     }
 
     void EntityManager::setup()
     {
-        for (auto &entity_pair : entity_list)
+        for (size_t i = 0; i < active_count; i++)
         {
-            entity_pair.second.get()->setup();
+            entities[i].setup();
         }
     }
 
     void EntityManager::update(const float delta_time)
     {
-        for (auto &entity_pair : entity_list)
+        for (size_t i = 0; i < active_count; i++)
         {
-            entity_pair.second.get()->update(delta_time);
+            entities[i].update(delta_time);
         }
     }
 
     // Serialization
+    void EntityManager::capture(Snapshot &snapshot) const
+    {
+        snapshot.entities = entities;
+        snapshot.active_count = active_count;
+
+        snapshot.slots = slots;
+        snapshot.generations = generations;
+        snapshot.free_indices = free_indices;
+
+        snapshot.name_index = name_index;
+    }
+
+    void EntityManager::restore(const Snapshot &snapshot)
+    {
+        entities = snapshot.entities;
+        active_count = snapshot.active_count;
+
+        slots = snapshot.slots;
+        generations = snapshot.generations;
+        free_indices = snapshot.free_indices;
+
+        name_index = snapshot.name_index;
+
+        hierarchy_dirty = true;
+        hierarchy_version++;
+    }
+
+    size_t EntityManager::Snapshot::get_byte_size() const
+    {
+        size_t bytes = entities.size() * sizeof(Entity);
+        for (const Entity &entity : entities)
+            bytes += entity.children_ids.size() * sizeof(EntityID);
+
+        bytes += (slots.size() + generations.size() + free_indices.size()) * sizeof(uint32_t);
+
+        for (const std::vector<EntityID> &bucket : name_index)
+            bytes += bucket.size() * sizeof(EntityID);
+
+        return bytes;
+    }
+
     void EntityManager::serialize(Serialization::SerializationContext &ctx) const
     {
         ctx.begin_array_key("entities");
 
-        for (const auto &[id, entity_ptr] : entity_list)
+        for (const Entity &entity : entities)
         {
             ctx.begin_object_push();
-            entity_ptr->serialize(ctx);
+            entity.serialize(ctx);
             ctx.end_object();
         }
 
@@ -114,33 +615,61 @@ namespace Engine
 
     void EntityManager::deserialize(Serialization::SerializationContext &ctx)
     {
-        entity_list.clear();
+        entities.clear();
+        active_count = 0;
+        slots.clear();
+        name_index.clear();
         generations.clear();
         free_indices.clear();
 
         ctx.begin_array_key("entities");
 
+        entities.reserve(ctx.size());
+
         for (int i = 0; i < ctx.size(); i++)
         {
             ctx.begin_object_index(i);
 
-            auto entity = std::make_unique<Entity>("");
-            entity->deserialize(ctx);
+            Entity &entity = entities.emplace_back(StringTable::INVALID_STRING);
+            entity.set_manager(this);
+            entity.deserialize(ctx);
 
-            EntityID id = entity->get_id();
+            EntityID id = entity.get_id();
+            index_name(id, entity.name_id);
 
             if (id.index >= generations.size())
             {
                 generations.resize(id.index + 1, 0);
+                slots.resize(id.index + 1, INVALID_SLOT);
             }
             generations[id.index] = id.generation;
-
-            entity->set_manager(this);
-            entity_list[id] = std::move(entity);
+            slots[id.index] = static_cast<uint32_t>(entities.size() - 1);
 
             ctx.end_object();
         }
 
         ctx.end_array();
+
+        // Indices skipped by the saved stage can be handed out again
+        for (uint32_t index = 0; index < slots.size(); index++)
+        {
+            if (slots[index] == INVALID_SLOT)
+                free_indices.push_back(index);
+        }
+
+        // Everything starts active, refresh_active_states() applies the saved flags once components are loaded
+        active_count = entities.size();
+
+        // Only parent links are saved, children lists are derived from them
+        for (Entity &entity : entities)
+        {
+            if (Entity *parent = get_entity_by_id(entity.parent_id))
+                parent->children_ids.push_back(entity.id);
+            else
+                entity.parent_id = EntityID::Invalid;
+        }
+
+        hierarchy_dirty = true;
+        hierarchy_version++;
     }
 }
@@ -2,19 +2,14 @@
 
 #include "engine/stage/stage_manager.h"
 #include "engine/component/component_manager.h"
+#include "engine/runtime/engine_instance.h"
 
 #include "engine/component/3d/transform_3d.h"
 
 namespace Engine::Graphics
 {
     RenderManager::RenderManager() : stage_manager(StageManager::get_instance()) {}
-    RenderManager::~RenderManager()
-    {
-        ComponentManager &component_manager = stage_manager.get_current_stage()->get_component_manager();
-
-        component_manager.component_created.unsubscribe(on_component_created_token);
-        component_manager.component_destroyed.unsubscribe(on_component_destroyed_token);
-    }
+    RenderManager::~RenderManager() = default;
 
     void RenderManager::init()
     {
@@ -22,64 +17,115 @@ namespace Engine::Graphics
         if (stage_ptr == nullptr)
             throw std::runtime_error("current_stage is null");
 
-        ComponentManager &component_manager = stage_ptr->get_component_manager();
-
-        camera_components = component_manager.get_components_by_type<Camera3D>();
-
-        on_component_created_token = component_manager.component_created.subscribe(this, &RenderManager::on_component_created);
-        on_component_destroyed_token = component_manager.component_destroyed.subscribe(this, &RenderManager::on_component_destroyed);
-
         Entity *test = stage_ptr->get_entity_manager().create_entity("Test");
         test->add_component<Transform3D>();
     }
 
-    void RenderManager::on_component_created(std::weak_ptr<Component> component_ptr)
+    void RenderManager::render()
     {
-        auto component_shared_ptr = component_ptr.lock();
-        assert(component_shared_ptr);
-
-        std::shared_ptr<Camera3D> camera = std::dynamic_pointer_cast<Camera3D>(component_shared_ptr);
-        if (camera)
-            camera_components.push_back(camera);
+        extract(immediate_packet);
+        render_packet(immediate_packet);
     }
 
-    void RenderManager::on_component_destroyed(std::weak_ptr<Component> component_ptr)
+    void RenderManager::extract(FramePacket &packet)
     {
-        ComponentManager &component_manager = stage_manager.get_current_stage()->get_component_manager();
-        camera_components = component_manager.get_components_by_type<Camera3D>();
+        packet.clear();
+        packet.frame = ++frame_counter;
+        packet.time_passed = EngineInstance::get_instance().get_time_passed();
+
+        Stage *stage_ptr = stage_manager.get_current_stage();
+        if (stage_ptr == nullptr)
+            return;
+
+        ComponentID primary_id = ComponentID::Invalid;
+        if (const Camera3D *primary = stage_ptr->get_component_manager().read_component(primary_camera))
+            primary_id = primary->get_id();
+
+        for (auto [entity, transform, camera] : stage_ptr->view<const Transform3D, const Camera3D>())
+        {
+            if (camera.get_id() == primary_id)
+                packet.primary_camera = packet.cameras.size();
+
+            camera.extract(transform, packet.cameras.emplace_back());
+        }
+
+        if (packet.primary_camera == FramePacket::NO_CAMERA && !packet.cameras.empty())
+            packet.primary_camera = 0;
+
+        auto transforms = stage_ptr->view<const Transform3D>();
+        packet.objects.reserve(transforms.size());
+
+        for (auto [entity, transform] : transforms)
+            packet.objects.push_back({entity, transform.get_world_matrix()});
     }
 
-    void RenderManager::render()
+    void RenderManager::render_packet(const FramePacket &packet)
     {
-        for (auto &camera_component_weak : camera_components)
+        for (const CameraPacket &camera : packet.cameras)
         {
-            assert(!camera_component_weak.expired());
+            Viewport *viewport = ensure_viewport(camera, packet.frame);
+            if (!viewport || !viewport->is_valid())
+                continue;
+
+            viewport->begin_frame();
 
-            std::shared_ptr<Camera3D> camera_component_ptr = camera_component_weak.lock();
-            camera_component_ptr->render();
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            if (camera.on_render_scene)
+                camera.on_render_scene(camera.view, camera.projection, packet);
+
+            viewport->end_frame();
+        }
+
+        presented_camera = packet.primary_camera != FramePacket::NO_CAMERA ? packet.cameras[packet.primary_camera].camera
+                                                                            : ComponentID::Invalid;
+
+        // Release the viewports of cameras that were destroyed or stopped rendering
+        for (auto it = render_targets.begin(); it != render_targets.end();)
+        {
+            if (it->second.frame != packet.frame)
+                it = render_targets.erase(it);
+            else
+                ++it;
         }
+
+        // Presenting here keeps every use of the render targets on the thread that draws them
+        present_to_window(present_window.load(std::memory_order_acquire));
     }
 
-    void RenderManager::present_to_window(Platform::Window *window)
+    Viewport *RenderManager::ensure_viewport(const CameraPacket &camera, uint64_t frame)
     {
-        if (!window)
-            return;
+        RenderTarget &target = render_targets[camera.camera];
+        target.frame = frame;
 
-        if (camera_components.empty())
-            return;
+        if (!target.viewport)
+        {
+            target.viewport = std::make_unique<Viewport>(camera.width, camera.height);
 
-        std::shared_ptr<Camera3D> primary;
-        for (auto &wp : camera_components)
+            if (!target.viewport->initialize())
+                throw std::runtime_error("Failed to initialize camera viewport");
+        }
+        else if (target.viewport->get_width() != camera.width || target.viewport->get_height() != camera.height)
         {
-            primary = wp.lock();
-            if (primary)
-                break;
+            target.viewport->resize(camera.width, camera.height);
         }
 
-        if (!primary)
+        return target.viewport.get();
+    }
+
+    Viewport *RenderManager::get_viewport(const ComponentID &camera) const
+    {
+        auto it = render_targets.find(camera);
+        return it != render_targets.end() ? it->second.viewport.get() : nullptr;
+    }
+
+    void RenderManager::present_to_window(Platform::Window *window)
+    {
+        if (!window)
             return;
 
-        auto vp = primary->get_viewport();
+        Viewport *vp = get_viewport(presented_camera);
         if (!vp || !vp->is_valid())
             return;
 
@@ -0,0 +1,188 @@
+#include "engine/jobs/job_system.h"
+
+#include "engine/debug/logging/logger.h"
+
+#include <string>
+
+namespace Engine
+{
+    namespace
+    {
+        // Identifies the worker running on this thread, if any
+        thread_local const JobSystem *current_job_system = nullptr;
+        thread_local size_t current_worker_index = 0;
+    }
+
+    JobSystem::JobSystem(size_t worker_count)
+    {
+        size_t queue_count = std::max<size_t>(1, worker_count);
+
+        queues.reserve(queue_count);
+        for (size_t i = 0; i < queue_count; i++)
+            queues.push_back(std::make_unique<WorkerQueue>());
+
+        workers.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; i++)
+            workers.emplace_back(&JobSystem::worker_loop, this, i);
+
+        Logger::log_info("[JobSystem] Started " + std::to_string(worker_count) + " worker threads");
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            running = false;
+        }
+        wake_condition.notify_all();
+
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    size_t JobSystem::get_default_worker_count()
+    {
+        unsigned int hardware_threads = std::thread::hardware_concurrency();
+        if (hardware_threads <= 1)
+            return 0;
+
+        return hardware_threads - 1;
+    }
+
+    void JobSystem::submit(std::function<void()> job, JobCounter *counter)
+    {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        size_t queue_index = current_job_system == this
+                                 ? current_worker_index
+                                 : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+        {
+            WorkerQueue &queue = *queues[queue_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({std::move(job), counter});
+        }
+
+        queued_jobs.fetch_add(1, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wake_condition.notify_one();
+    }
+
+    void JobSystem::wait(JobCounter &counter)
+    {
+        while (!counter.is_done())
+        {
+            Job job;
+            if (try_get_job(job))
+                execute(job);
+            else
+                std::this_thread::yield();
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(counter.error_mutex);
+            std::swap(error, counter.error);
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void JobSystem::worker_loop(size_t worker_index)
+    {
+        current_job_system = this;
+        current_worker_index = worker_index;
+
+        while (running)
+        {
+            Job job;
+            if (try_get_job(job))
+            {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake_condition.wait(lock, [this]()
+                                { return queued_jobs.load(std::memory_order_acquire) > 0 || !running; });
+        }
+
+        current_job_system = nullptr;
+    }
+
+    bool JobSystem::try_pop(size_t queue_index, Job &job)
+    {
+        WorkerQueue &queue = *queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.jobs.empty())
+            return false;
+
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool JobSystem::try_steal(size_t thief_index, Job &job)
+    {
+        for (size_t offset = 1; offset <= queues.size(); offset++)
+        {
+            WorkerQueue &queue = *queues[(thief_index + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.jobs.empty())
+                continue;
+
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool JobSystem::try_get_job(Job &job)
+    {
+        if (queued_jobs.load(std::memory_order_acquire) == 0)
+            return false;
+
+        bool found = current_job_system == this
+                         ? try_pop(current_worker_index, job) || try_steal(current_worker_index, job)
+                         : try_steal(next_queue.load(std::memory_order_relaxed), job);
+
+        if (found)
+            queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+
+        return found;
+    }
+
+    void JobSystem::execute(Job &job)
+    {
+        try
+        {
+            job.function();
+        }
+        catch (...)
+        {
+            if (job.counter)
+                record_error(*job.counter, std::current_exception());
+            else
+                Logger::log_error("[JobSystem] Uncaught exception in job without a counter");
+        }
+
+        if (job.counter)
+            job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void JobSystem::record_error(JobCounter &counter, std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(counter.error_mutex);
+        if (!counter.error)
+            counter.error = error;
+    }
+}
@@ -162,18 +162,18 @@ namespace Engine::Math
 
         Matrix4 result = identity();
 
-        // set rotation basis in columns
+        // set rotation basis in rows, the inverse of the camera's orientation
         result[0][0] = s.x;
-        result[0][1] = s.y;
-        result[0][2] = s.z;
-        result[0][3] = 0.0f;
-        result[1][0] = u.x;
+        result[1][0] = s.y;
+        result[2][0] = s.z;
+        result[0][1] = u.x;
         result[1][1] = u.y;
-        result[1][2] = u.z;
-        result[1][3] = 0.0f;
-        result[2][0] = -f.x;
-        result[2][1] = -f.y;
+        result[2][1] = u.z;
+        result[0][2] = -f.x;
+        result[1][2] = -f.y;
         result[2][2] = -f.z;
+        result[0][3] = 0.0f;
+        result[1][3] = 0.0f;
         result[2][3] = 0.0f;
 
         // translation (last column)
@@ -0,0 +1,177 @@
+#include "engine/math/matrix4_batch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TETRA_TRS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TETRA_TRS_SSE 1
+#endif
+
+namespace Engine::Math
+{
+    namespace
+    {
+        /**
+         * @brief Computes the 16 matrix elements of one lane group, column by column.
+         *
+         * Written once against a small set of vector operations so the SSE and AVX paths
+         * share the exact same arithmetic as the scalar kernel.
+         */
+        template <typename Ops>
+        void compose_elements(const TRSBatch &batch, size_t i, typename Ops::V (&columns)[4][4])
+        {
+            using V = typename Ops::V;
+
+            V x = Ops::load(batch.rotation_x + i);
+            V y = Ops::load(batch.rotation_y + i);
+            V z = Ops::load(batch.rotation_z + i);
+            V w = Ops::load(batch.rotation_w + i);
+
+            V sx = Ops::load(batch.scale_x + i);
+            V sy = Ops::load(batch.scale_y + i);
+            V sz = Ops::load(batch.scale_z + i);
+
+            V one = Ops::set1(1.0f);
+            V two = Ops::set1(2.0f);
+            V zero = Ops::set1(0.0f);
+
+            V xx = Ops::mul(x, x), yy = Ops::mul(y, y), zz = Ops::mul(z, z);
+            V xy = Ops::mul(x, y), xz = Ops::mul(x, z), yz = Ops::mul(y, z);
+            V wx = Ops::mul(w, x), wy = Ops::mul(w, y), wz = Ops::mul(w, z);
+
+            columns[0][0] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(yy, zz))), sx);
+            columns[0][1] = Ops::mul(Ops::mul(two, Ops::add(xy, wz)), sx);
+            columns[0][2] = Ops::mul(Ops::mul(two, Ops::sub(xz, wy)), sx);
+            columns[0][3] = zero;
+
+            columns[1][0] = Ops::mul(Ops::mul(two, Ops::sub(xy, wz)), sy);
+            columns[1][1] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, zz))), sy);
+            columns[1][2] = Ops::mul(Ops::mul(two, Ops::add(yz, wx)), sy);
+            columns[1][3] = zero;
+
+            columns[2][0] = Ops::mul(Ops::mul(two, Ops::add(xz, wy)), sz);
+            columns[2][1] = Ops::mul(Ops::mul(two, Ops::sub(yz, wx)), sz);
+            columns[2][2] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, yy))), sz);
+            columns[2][3] = zero;
+
+            columns[3][0] = Ops::load(batch.position_x + i);
+            columns[3][1] = Ops::load(batch.position_y + i);
+            columns[3][2] = Ops::load(batch.position_z + i);
+            columns[3][3] = one;
+        }
+
+        struct ScalarOps
+        {
+            using V = float;
+
+            static V load(const float *p) { return *p; }
+            static V set1(float v) { return v; }
+            static V add(V a, V b) { return a + b; }
+            static V sub(V a, V b) { return a - b; }
+            static V mul(V a, V b) { return a * b; }
+        };
+
+#if defined(TETRA_TRS_SSE) || defined(TETRA_TRS_AVX)
+        // Turns four row registers of one column (lanes = transforms) into that column of four matrices
+        inline void store_column_sse(__m128 r0, __m128 r1, __m128 r2, __m128 r3, int column, Matrix4 *out)
+        {
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(out[0].m[column], r0);
+            _mm_storeu_ps(out[1].m[column], r1);
+            _mm_storeu_ps(out[2].m[column], r2);
+            _mm_storeu_ps(out[3].m[column], r3);
+        }
+#endif
+
+#if defined(TETRA_TRS_AVX)
+        struct AvxOps
+        {
+            using V = __m256;
+            static constexpr size_t WIDTH = 8;
+
+            static V load(const float *p) { return _mm256_loadu_ps(p); }
+            static V set1(float v) { return _mm256_set1_ps(v); }
+            static V add(V a, V b) { return _mm256_add_ps(a, b); }
+            static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+            static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+
+            static void store(V (&columns)[4][4], Matrix4 *out)
+            {
+                for (int c = 0; c < 4; c++)
+                {
+                    store_column_sse(_mm256_castps256_ps128(columns[c][0]), _mm256_castps256_ps128(columns[c][1]),
+                                     _mm256_castps256_ps128(columns[c][2]), _mm256_castps256_ps128(columns[c][3]),
+                                     c, out);
+
+                    store_column_sse(_mm256_extractf128_ps(columns[c][0], 1), _mm256_extractf128_ps(columns[c][1], 1),
+                                     _mm256_extractf128_ps(columns[c][2], 1), _mm256_extractf128_ps(columns[c][3], 1),
+                                     c, out + 4);
+                }
+            }
+        };
+
+        using SimdOps = AvxOps;
+#elif defined(TETRA_TRS_SSE)
+        struct SseOps
+        {
+            using V = __m128;
+            static constexpr size_t WIDTH = 4;
+
+            static V load(const float *p) { return _mm_loadu_ps(p); }
+            static V set1(float v) { return _mm_set1_ps(v); }
+            static V add(V a, V b) { return _mm_add_ps(a, b); }
+            static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+            static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+
+            static void store(V (&columns)[4][4], Matrix4 *out)
+            {
+                for (int c = 0; c < 4; c++)
+                    store_column_sse(columns[c][0], columns[c][1], columns[c][2], columns[c][3], c, out);
+            }
+        };
+
+        using SimdOps = SseOps;
+#endif
+    }
+
+    void compose_trs_scalar(const TRSBatch &batch, size_t count, Matrix4 *out)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            float columns[4][4];
+            compose_elements<ScalarOps>(batch, i, columns);
+
+            for (int c = 0; c < 4; c++)
+                for (int r = 0; r < 4; r++)
+                    out[i].m[c][r] = columns[c][r];
+        }
+    }
+
+    void compose_trs(const TRSBatch &batch, size_t count, Matrix4 *out)
+    {
+        size_t i = 0;
+
+#if defined(TETRA_TRS_AVX) || defined(TETRA_TRS_SSE)
+        for (; i + SimdOps::WIDTH <= count; i += SimdOps::WIDTH)
+        {
+            SimdOps::V columns[4][4];
+            compose_elements<SimdOps>(batch, i, columns);
+            SimdOps::store(columns, out + i);
+        }
+#endif
+
+        if (i == count)
+            return;
+
+        // Remainder that does not fill a whole register
+        TRSBatch tail = batch;
+        for (const float **p : {&tail.position_x, &tail.position_y, &tail.position_z,
+                                &tail.rotation_x, &tail.rotation_y, &tail.rotation_z, &tail.rotation_w,
+                                &tail.scale_x, &tail.scale_y, &tail.scale_z})
+            *p += i;
+
+        compose_trs_scalar(tail, count - i, out + i);
+    }
+}
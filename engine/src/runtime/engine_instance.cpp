@@ -8,6 +8,10 @@
 #include "engine/debug/logging/console_sink.h"
 #include "engine/debug/logging/logger.h"
 
+#ifndef TETRA_HEADLESS
+#include "engine/graphics/render_manager.h"
+#endif
+
 namespace Engine
 {
     EngineInstance::EngineInstance() {}
@@ -30,8 +34,20 @@ namespace Engine
         // Start main engine loop
         using clock = std::chrono::high_resolution_clock;
 
-        constexpr double fixed_timestep = 1.0 / 60.0; // Physics tick rate
-        double accumulator = 0.0;
+#ifndef TETRA_HEADLESS
+        if (pipelined_rendering)
+        {
+            Logger::log_info("[EngineInstance] Rendering on a separate render thread");
+
+            // The render thread has to own the GL context from here on
+            frame_pipeline.start([](const Graphics::FramePacket &packet)
+                                 { Graphics::RenderManager::get_instance().render_packet(packet); });
+        }
+#endif
+
+        // Registered stages, e.g. one per match on a dedicated server, run on threads of their own
+        if (stage_manager.get_stage_count() > 0)
+            stage_manager.start_stages();
 
         auto previous_time = clock::now();
 
@@ -42,40 +58,72 @@ namespace Engine
             previous_time = current_time;
 
             double frame_time = delta_time_duration.count();
-            accumulator += frame_time;
 
             // TODO: Do input handling with something like this?
             // current_stage->handle_input();
 
-            // Wait idly for physics simulation if frame time is too low
-            while (accumulator >= fixed_timestep)
-            {
-                // TODO: Update physics backend
-                stage_manager.get_current_stage()->physics_update(fixed_timestep);
-                accumulator -= fixed_timestep;
-            }
-
             delta_time = frame_time;
             time_passed += delta_time;
 
-            stage_manager.get_current_stage()->update(delta_time);
-            Graphics::RenderManager::get_instance().render();
+            // Runs the stage's fixed steps for this frame, then its regular update
+            stage_manager.get_current_stage()->tick(frame_time);
+
+            render_frame();
 
-            // TODO: Add vsync / framerate cap / sleep?
+            // Sleep off the rest of the frame instead of spinning
+            frame_pacer.wait();
         }
 
+        stage_manager.stop_stages();
+        frame_pipeline.stop();
+
+        const FramePacer::Stats &pacing = frame_pacer.get_stats();
+        Logger::log_info("[EngineInstance] Paced " + std::to_string(pacing.frames) + " frames, " +
+                         std::to_string(pacing.missed_deadlines) + " missed, max overshoot " +
+                         std::to_string(pacing.max_overshoot_milliseconds) + " ms");
+
         return 0; // Handle shutdown gracefully
     }
 
+    void EngineInstance::render_frame()
+    {
+#ifndef TETRA_HEADLESS
+        Graphics::RenderManager &render_manager = Graphics::RenderManager::get_instance();
+
+        if (!frame_pipeline.is_running())
+        {
+            render_manager.render();
+            return;
+        }
+
+        // Extract now, the render thread draws the packet while the next frame simulates
+        render_manager.extract(frame_pipeline.begin_extract());
+        frame_pipeline.submit();
+#endif
+    }
+
     void EngineInstance::init(const std::string &project_path)
     {
         std::shared_ptr<LogSink> console_sink = std::make_shared<ConsoleSink>();
         Logger::get_instance().add_sink(console_sink);
 
         ProjectManager::get_instance().init(project_path + "/project.tetra");
-        Asset::AssetManager::get_instance().init(project_path);
+
+        int worker_thread_count = ProjectManager::get_instance().get_project_settings().worker_thread_count;
+        job_system = std::make_unique<JobSystem>(worker_thread_count < 0 ? JobSystem::get_default_worker_count()
+                                                                        : static_cast<size_t>(worker_thread_count));
+
+        ProjectSettings project_settings = ProjectManager::get_instance().get_project_settings();
+        frame_pacer.set_target_rate(project_settings.target_frame_rate);
+        pipelined_rendering = project_settings.pipelined_rendering;
+
+        Asset::AssetManager::get_instance().init(project_path, job_system.get());
+
+        StageManager::get_instance().set_job_system(job_system.get());
         StageManager::get_instance().load_new_stage();
 
+#ifndef TETRA_HEADLESS
         Graphics::RenderManager::get_instance().init();
+#endif
     }
 }
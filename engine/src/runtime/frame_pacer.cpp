@@ -0,0 +1,69 @@
+#include "engine/runtime/frame_pacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace Engine
+{
+    FramePacer::FramePacer(double target_rate)
+    {
+        set_target_rate(target_rate);
+    }
+
+    void FramePacer::set_target_rate(double target_rate)
+    {
+        this->target_rate = target_rate > 0.0 ? target_rate : 0.0;
+        period = this->target_rate > 0.0
+                     ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / this->target_rate))
+                     : clock::duration::zero();
+
+        has_deadline = false;
+    }
+
+    void FramePacer::set_spin_window(double seconds)
+    {
+        spin_window = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(std::max(seconds, 0.0)));
+    }
+
+    void FramePacer::wait()
+    {
+        if (period == clock::duration::zero())
+            return;
+
+        clock::time_point now = clock::now();
+
+        if (!has_deadline)
+        {
+            deadline = now;
+            has_deadline = true;
+        }
+
+        deadline += period;
+
+        // Missed the deadline, start over from now instead of running late frames back to back
+        if (now > deadline)
+        {
+            stats.missed_deadlines++;
+            deadline = now;
+        }
+
+        clock::time_point sleep_until = deadline - spin_window;
+        if (now < sleep_until)
+        {
+            std::this_thread::sleep_until(sleep_until);
+
+            std::chrono::duration<double, std::milli> sleep_overshoot = clock::now() - sleep_until;
+            stats.max_sleep_overshoot_milliseconds = std::max(stats.max_sleep_overshoot_milliseconds, sleep_overshoot.count());
+        }
+
+        while (clock::now() < deadline)
+            std::this_thread::yield();
+
+        std::chrono::duration<double, std::milli> overshoot = clock::now() - deadline;
+
+        stats.frames++;
+        stats.last_overshoot_milliseconds = overshoot.count();
+        stats.max_overshoot_milliseconds = std::max(stats.max_overshoot_milliseconds, overshoot.count());
+        stats.average_overshoot_milliseconds += (overshoot.count() - stats.average_overshoot_milliseconds) / static_cast<double>(stats.frames);
+    }
+}
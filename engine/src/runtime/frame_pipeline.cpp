@@ -0,0 +1,173 @@
+#include "engine/runtime/frame_pipeline.h"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace Engine
+{
+    FramePipeline::~FramePipeline()
+    {
+        try
+        {
+            stop();
+        }
+        catch (const std::exception &)
+        {
+            // Errors should be collected through stop() before destruction
+        }
+    }
+
+    void FramePipeline::start(RenderFunction render)
+    {
+        if (is_running())
+            throw std::runtime_error("FramePipeline is already running!");
+
+        this->render = std::move(render);
+
+        pending_index = NO_PACKET;
+        rendering_index = NO_PACKET;
+        stop_requested = false;
+        render_error = nullptr;
+        write_index = 0;
+
+        render_thread = std::thread(&FramePipeline::run_render_thread, this);
+    }
+
+    void FramePipeline::stop()
+    {
+        if (!is_running())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop_requested = true;
+        }
+        condition.notify_all();
+
+        render_thread.join();
+
+        std::exception_ptr error = nullptr;
+        std::swap(error, render_error);
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    Graphics::FramePacket &FramePipeline::begin_extract()
+    {
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]()
+                       { return rendering_index != write_index || render_error; });
+
+        std::chrono::duration<double, std::milli> waited = clock::now() - start;
+        stats.last_wait_milliseconds = waited.count();
+
+        lock.unlock();
+        rethrow_render_error();
+
+        return packets[write_index];
+    }
+
+    void FramePipeline::submit()
+    {
+        if (!is_running())
+            throw std::runtime_error("FramePipeline is not running!");
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // The render thread picks a packet up before drawing it, so this only waits when it fell behind
+            condition.wait(lock, [this]()
+                           { return pending_index == NO_PACKET || render_error; });
+
+            if (!render_error)
+                pending_index = write_index;
+        }
+        condition.notify_all();
+
+        rethrow_render_error();
+
+        write_index = 1 - write_index;
+    }
+
+    void FramePipeline::wait_idle()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]()
+                       { return (pending_index == NO_PACKET && rendering_index == NO_PACKET) || render_error; });
+    }
+
+    void FramePipeline::run_render_thread()
+    {
+        using clock = std::chrono::steady_clock;
+
+        while (true)
+        {
+            size_t index;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]()
+                               { return pending_index != NO_PACKET || stop_requested; });
+
+                if (pending_index == NO_PACKET)
+                    return;
+
+                index = pending_index;
+                rendering_index = index;
+                pending_index = NO_PACKET;
+            }
+            condition.notify_all();
+
+            auto start = clock::now();
+
+            try
+            {
+                render(packets[index]);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                render_error = std::current_exception();
+            }
+
+            std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+
+            bool failed;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                rendering_index = NO_PACKET;
+                stats.rendered_frames++;
+                stats.last_render_milliseconds = elapsed.count();
+                failed = render_error != nullptr;
+            }
+            condition.notify_all();
+
+            if (failed)
+                return;
+        }
+    }
+
+    FramePipeline::Stats FramePipeline::get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void FramePipeline::rethrow_render_error()
+    {
+        std::exception_ptr error;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = render_error;
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,261 @@
+#include "engine/stage/command_buffer.h"
+
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/stage/stage.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <unordered_map>
+
+namespace Engine
+{
+    namespace
+    {
+        std::atomic<uint64_t> next_pool_id{1};
+
+        // Buffers this thread used most recently, one per pool, so repeated get_local calls skip the lock.
+        // Workers shared by several stages alternate between their pools, a few slots cover that.
+        struct LocalBufferCache
+        {
+            static constexpr size_t SLOT_COUNT = 8;
+
+            struct Slot
+            {
+                uint64_t pool_id = 0;
+                CommandBuffer *buffer = nullptr;
+            };
+
+            std::array<Slot, SLOT_COUNT> slots;
+            size_t next_slot = 0;
+
+            CommandBuffer *find(uint64_t pool_id) const
+            {
+                for (const Slot &slot : slots)
+                {
+                    if (slot.pool_id == pool_id)
+                        return slot.buffer;
+                }
+
+                return nullptr;
+            }
+
+            // Replaces the oldest slot once all are taken
+            void insert(uint64_t pool_id, CommandBuffer *buffer)
+            {
+                slots[next_slot] = {pool_id, buffer};
+                next_slot = (next_slot + 1) % SLOT_COUNT;
+            }
+        };
+
+        thread_local LocalBufferCache local_buffer_cache;
+    }
+
+    CommandBuffer::PendingEntity CommandBuffer::create_entity(std::string name)
+    {
+        PendingEntity entity = {pending_entity_count++};
+
+        Command command;
+        command.type = CommandType::CreateEntity;
+        command.target = {EntityID::Invalid, entity.index};
+        command.payload = static_cast<uint32_t>(names.size());
+
+        names.push_back(std::move(name));
+        commands.push_back(command);
+
+        return entity;
+    }
+
+    void CommandBuffer::destroy_entity(EntityID entity)
+    {
+        commands.push_back({CommandType::DestroyEntity, target_of(entity)});
+    }
+
+    void CommandBuffer::destroy_entity(PendingEntity entity)
+    {
+        commands.push_back({CommandType::DestroyEntity, target_of(entity)});
+    }
+
+    void CommandBuffer::record_add(Target target, std::unique_ptr<Component> component)
+    {
+        Command command;
+        command.type = CommandType::AddComponent;
+        command.target = target;
+        command.component_type = component->get_type_id();
+        command.payload = static_cast<uint32_t>(components.size());
+
+        components.push_back(std::move(component));
+        commands.push_back(command);
+    }
+
+    void CommandBuffer::record_remove(Target target, ComponentTypeID type_id)
+    {
+        Command command;
+        command.type = CommandType::RemoveComponent;
+        command.target = target;
+        command.component_type = type_id;
+
+        commands.push_back(command);
+    }
+
+    void CommandBuffer::clear()
+    {
+        commands.clear();
+        names.clear();
+        components.clear();
+        pending_entity_count = 0;
+    }
+
+    CommandBufferPool::CommandBufferPool() : pool_id(next_pool_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+    CommandBuffer &CommandBufferPool::get_local()
+    {
+        LocalBufferCache &cache = local_buffer_cache;
+        if (CommandBuffer *buffer = cache.find(pool_id))
+            return *buffer;
+
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+
+        std::thread::id thread_id = std::this_thread::get_id();
+
+        auto it = std::find_if(buffers.begin(), buffers.end(), [thread_id](const auto &entry)
+                               { return entry.first == thread_id; });
+
+        if (it == buffers.end())
+        {
+            buffers.emplace_back(thread_id, std::make_unique<CommandBuffer>());
+            it = buffers.end() - 1;
+        }
+
+        cache.insert(pool_id, it->second.get());
+        return *it->second;
+    }
+
+    bool CommandBufferPool::empty() const
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+
+        return std::all_of(buffers.begin(), buffers.end(), [](const auto &entry)
+                           { return entry.second->empty(); });
+    }
+
+    void CommandBufferPool::playback(Stage &stage)
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+
+        EntityManager &entity_manager = stage.get_entity_manager();
+        ComponentManager &component_manager = stage.get_component_manager();
+
+        // Net effect of the batch on each touched entity, in first-touched order
+        struct EntityChanges
+        {
+            EntityID entity;
+            bool destroyed = false;
+            ComponentSignature removed;
+            std::vector<ComponentManager::PendingComponent> added;
+        };
+
+        std::vector<EntityChanges> changes;
+        std::unordered_map<EntityID, size_t> change_indices;
+
+        auto changes_of = [&](EntityID entity) -> EntityChanges &
+        {
+            auto [it, inserted] = change_indices.try_emplace(entity, changes.size());
+            if (inserted)
+                changes.push_back(EntityChanges{entity, false, {}, {}});
+
+            return changes[it->second];
+        };
+
+        try
+        {
+            for (auto &[thread_id, buffer] : buffers)
+            {
+                // Entities created and destroyed within the batch are never created at all
+                std::vector<bool> pending_destroyed(buffer->pending_entity_count, false);
+                for (const CommandBuffer::Command &command : buffer->commands)
+                {
+                    if (command.type == CommandBuffer::CommandType::DestroyEntity && command.target.pending != CommandBuffer::NOT_PENDING)
+                        pending_destroyed[command.target.pending] = true;
+                }
+
+                std::vector<EntityID> created(buffer->pending_entity_count, EntityID::Invalid);
+
+                for (const CommandBuffer::Command &command : buffer->commands)
+                {
+                    EntityID entity = command.target.entity;
+
+                    if (command.target.pending != CommandBuffer::NOT_PENDING)
+                    {
+                        if (pending_destroyed[command.target.pending])
+                            continue;
+
+                        if (command.type == CommandBuffer::CommandType::CreateEntity)
+                        {
+                            created[command.target.pending] = entity_manager.create_entity(std::move(buffer->names[command.payload]))->get_id();
+                            continue;
+                        }
+
+                        entity = created[command.target.pending];
+                    }
+
+                    EntityChanges &entity_changes = changes_of(entity);
+                    auto &added = entity_changes.added;
+
+                    auto existing = std::find_if(added.begin(), added.end(), [&command](const ComponentManager::PendingComponent &pending)
+                                                 { return pending.type == command.component_type; });
+
+                    switch (command.type)
+                    {
+                    case CommandBuffer::CommandType::DestroyEntity:
+                        entity_changes.destroyed = true;
+                        break;
+
+                    case CommandBuffer::CommandType::AddComponent:
+                    {
+                        Component *source = buffer->components[command.payload].get();
+                        if (existing != added.end())
+                            existing->source = source;
+                        else
+                            added.push_back({command.component_type, source});
+                        break;
+                    }
+
+                    case CommandBuffer::CommandType::RemoveComponent:
+                        if (existing != added.end())
+                            added.erase(existing);
+
+                        entity_changes.removed.set(command.component_type);
+                        break;
+
+                    default:
+                        break;
+                    }
+                }
+            }
+
+            for (EntityChanges &entity_changes : changes)
+            {
+                if (!entity_manager.has_entity(entity_changes.entity))
+                    continue;
+
+                if (entity_changes.destroyed)
+                    entity_manager.destroy_entity(entity_changes.entity);
+                else
+                    component_manager.apply_changes(entity_changes.entity, entity_changes.removed, entity_changes.added);
+            }
+        }
+        catch (...)
+        {
+            for (auto &[thread_id, buffer] : buffers)
+                buffer->clear();
+
+            throw;
+        }
+
+        for (auto &[thread_id, buffer] : buffers)
+            buffer->clear();
+    }
+}
@@ -0,0 +1,99 @@
+#include "engine/stage/prefab.h"
+#include "engine/stage/stage.h"
+#include "engine/entity/entity.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+
+#include <stdexcept>
+
+namespace Engine
+{
+    Prefab Prefab::bake(Stage &stage, const EntityID &root)
+    {
+        EntityManager &entity_manager = stage.get_entity_manager();
+        ComponentManager &component_manager = stage.get_component_manager();
+        const ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+        if (!entity_manager.has_entity(root))
+            throw std::runtime_error("Cannot bake a prefab from an entity that does not exist!");
+
+        std::vector<EntityID> subtree = {root};
+        entity_manager.collect_descendants(root, subtree);
+
+        Prefab prefab;
+        prefab.entities.reserve(subtree.size());
+
+        for (uint32_t i = 0; i < subtree.size(); i++)
+            prefab.entity_lookup[subtree[i]] = i;
+
+        // Source component IDs, in the same order as the template rows they were copied to
+        std::vector<std::vector<std::vector<ComponentID>>> source_ids;
+
+        for (uint32_t i = 0; i < subtree.size(); i++)
+        {
+            const Entity *entity = entity_manager.get_entity_by_id(subtree[i]);
+
+            PrefabEntity &baked = prefab.entities.emplace_back();
+            baked.name = entity->get_name();
+            baked.parent = i == 0 ? NO_PARENT : prefab.entity_lookup.at(entity->get_parent()->get_id());
+            baked.enabled = entity->is_enabled();
+
+            prefab.has_disabled |= !baked.enabled;
+
+            const ComponentManager::EntityLocation *location = component_manager.find_location(subtree[i]);
+            if (!location)
+                continue;
+
+            Archetype &source = *component_manager.archetypes[location->archetype];
+
+            size_t block_index = 0;
+            while (block_index < prefab.archetypes.size() && prefab.archetypes[block_index].signature != source.get_signature())
+                block_index++;
+
+            if (block_index == prefab.archetypes.size())
+            {
+                PrefabArchetype &block = prefab.archetypes.emplace_back();
+                block.signature = source.get_signature();
+                block.types = source.get_types();
+
+                for (ComponentTypeID type : block.types)
+                {
+                    block.columns.push_back(registry.create_column(type));
+                    if (!block.columns.back()->is_copyable())
+                        throw std::runtime_error("Cannot bake " + registry.get_type_name(type) + " into a prefab, it is not copyable!");
+
+                    prefab.remaps_references |= registry.remaps_references(type);
+                }
+
+                source_ids.emplace_back(block.types.size());
+            }
+
+            PrefabArchetype &block = prefab.archetypes[block_index];
+            block.entities.push_back(i);
+
+            for (size_t column = 0; column < block.types.size(); column++)
+            {
+                const ComponentColumnBase &source_column = source.get_column(column);
+
+                block.columns[column]->push_copy(source_column, location->row, 0);
+                source_ids[block_index][column].push_back(block.columns[column]->get(block.entities.size() - 1)->get_id());
+            }
+        }
+
+        // Component order within an instance: block by block, column by column, row by row
+        for (size_t block_index = 0; block_index < prefab.archetypes.size(); block_index++)
+        {
+            PrefabArchetype &block = prefab.archetypes[block_index];
+            block.component_offset = static_cast<uint32_t>(prefab.component_count);
+
+            for (const std::vector<ComponentID> &column_ids : source_ids[block_index])
+            {
+                for (const ComponentID &id : column_ids)
+                    prefab.component_lookup[id] = static_cast<uint32_t>(prefab.component_count++);
+            }
+        }
+
+        return prefab;
+    }
+}
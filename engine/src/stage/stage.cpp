@@ -1,15 +1,18 @@
 ﻿#include "engine/stage/stage.h"
 
-#include "engine/graphics/viewport.h"
 #include "engine/entity/entity.h"
 #include "engine/component/component.h"
 #include "engine/component/component_manager.h"
 
 #include <memory>
 
+#ifndef TETRA_HEADLESS
+#include "engine/graphics/viewport.h"
+#endif
+
 namespace Engine
 {
-    Stage::Stage(bool headless) : headless(headless)
+    Stage::Stage(bool headless) : guid(GUID::generate()), headless(headless)
     {
         entity_manager = std::make_unique<EntityManager>(this);
         component_manager = std::make_unique<ComponentManager>(this);
@@ -28,6 +31,7 @@ namespace Engine
 
     void Stage::render()
     {
+#ifndef TETRA_HEADLESS
         if (is_headless())
             return;
 
@@ -36,25 +40,64 @@ namespace Engine
         // TODO: Render things
 
         viewport->end_frame();
+#endif
     }
 
     void Stage::update(const float delta_time)
     {
-        entity_manager->update(delta_time);
+        component_manager->advance_tick();
+
+        if (update_mode == ComponentUpdateMode::TypeBatched)
+            component_manager->update_components(delta_time);
+        else
+            entity_manager->update(delta_time);
+
+        system_scheduler.run(*this, delta_time);
+
+        // Sync point, structural changes recorded during the frame are applied here
+        command_buffers.playback(*this);
+
+        transform_propagation.run(*entity_manager, *component_manager);
     }
 
     void Stage::physics_update(float delta_time)
     {
     }
 
+    size_t Stage::tick(double frame_time)
+    {
+        accumulator += frame_time;
+
+        size_t steps = 0;
+        while (accumulator >= fixed_timestep && steps < MAX_FIXED_STEPS_PER_TICK)
+        {
+            // TODO: Update physics backend
+            physics_update(static_cast<float>(fixed_timestep));
+            accumulator -= fixed_timestep;
+            steps++;
+        }
+
+        // Falling behind, skip the steps that could not be caught up
+        if (accumulator >= fixed_timestep)
+            accumulator = 0.0;
+
+        update(static_cast<float>(frame_time));
+
+        return steps;
+    }
+
     bool Stage::is_headless() const
     {
+#ifdef TETRA_HEADLESS
+        return true;
+#else
         return headless || !viewport;
+#endif
     }
 
     bool Stage::has_requested_shutdown() const
     {
-        return requested_shutdown;
+        return requested_shutdown.load(std::memory_order_acquire);
     }
 
     EntityManager &Stage::get_entity_manager()
@@ -70,8 +113,16 @@ namespace Engine
     // Serialization
     void Stage::serialize(SerializationContext &ctx) const
     {
+        ctx.write("guid", guid.to_string());
+        ctx.write("name", name);
+
+        ctx.begin_object_key("entity_manager");
         entity_manager->serialize(ctx);
+        ctx.end_object();
+
+        ctx.begin_object_key("component_manager");
         component_manager->serialize(ctx);
+        ctx.end_object();
     }
 
     void Stage::deserialize(SerializationContext &ctx)
@@ -88,5 +139,7 @@ namespace Engine
         ctx.begin_object_key("component_manager");
         component_manager->deserialize(ctx);
         ctx.end_object();
+
+        entity_manager->refresh_active_states();
     }
 }
@@ -1,10 +1,18 @@
 ﻿#include "engine/stage/stage_manager.h"
+#include "engine/runtime/frame_pacer.h"
+#include "engine/serialization/json/json_document.h"
+#include "engine/serialization/json/json_serialization_context.h"
+#include "engine/utils/io.h"
+
+#include <chrono>
+#include <stdexcept>
 
 namespace Engine
 {
     std::unique_ptr<Stage> StageManager::create_empty_stage()
     {
         auto stage_ptr = std::make_unique<Stage>();
+        stage_ptr->set_job_system(job_system);
 
         return stage_ptr;
     }
@@ -13,4 +21,124 @@ namespace Engine
     {
         current_stage = create_empty_stage();
     }
+
+    Stage *StageManager::create_stage()
+    {
+        auto stage_ptr = std::make_unique<Stage>(true);
+        stage_ptr->set_job_system(job_system);
+
+        return register_stage(std::move(stage_ptr));
+    }
+
+    Stage *StageManager::create_stage(const std::string &path)
+    {
+        auto content_opt = Utils::IO::read_file_contents(path);
+        if (!content_opt.has_value())
+            throw std::runtime_error("Cannot read stage file " + path);
+
+        auto stage_ptr = std::make_unique<Stage>(true);
+        stage_ptr->set_job_system(job_system);
+
+        Serialization::JsonDocument doc(content_opt.value());
+        Serialization::JSONSerializationContext ctx(stage_ptr.get(), doc);
+        stage_ptr->deserialize(ctx);
+
+        Logger::log_info("[StageManager] Loaded stage " + path);
+
+        return register_stage(std::move(stage_ptr));
+    }
+
+    Stage *StageManager::register_stage(std::unique_ptr<Stage> stage_ptr)
+    {
+        Stage *stage = stage_ptr.get();
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        stage_registry.emplace(stage->get_guid(), std::move(stage_ptr));
+
+        return stage;
+    }
+
+    Stage *StageManager::get_stage(const GUID &guid) const
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        auto it = stage_registry.find(guid);
+        return it != stage_registry.end() ? it->second.get() : nullptr;
+    }
+
+    void StageManager::destroy_stage(const GUID &guid)
+    {
+        if (is_running())
+            throw std::runtime_error("Cannot destroy a stage while stages are running!");
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        stage_registry.erase(guid);
+    }
+
+    size_t StageManager::get_stage_count() const
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        return stage_registry.size();
+    }
+
+    void StageManager::start_stages()
+    {
+        if (is_running())
+            return;
+
+        stop_requested.store(false, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        stage_threads.reserve(stage_registry.size());
+        for (auto &[guid, stage] : stage_registry)
+        {
+            Stage *stage_ptr = stage.get();
+            stage_threads.emplace_back([this, stage_ptr]()
+                                       { run_stage(*stage_ptr); });
+        }
+
+        Logger::log_info("[StageManager] Started " + std::to_string(stage_threads.size()) + " stage threads");
+    }
+
+    void StageManager::stop_stages()
+    {
+        stop_requested.store(true, std::memory_order_release);
+
+        for (std::thread &thread : stage_threads)
+            thread.join();
+
+        stage_threads.clear();
+    }
+
+    void StageManager::run_stage(Stage &stage)
+    {
+        using clock = std::chrono::steady_clock;
+
+        // Headless stages have nothing to present, so sleep until the next step instead of spinning
+        FramePacer pacer(1.0 / stage.get_fixed_timestep());
+
+        auto previous_time = clock::now();
+
+        while (!stop_requested.load(std::memory_order_acquire) && !stage.has_requested_shutdown())
+        {
+            auto current_time = clock::now();
+            std::chrono::duration<double> frame_time = current_time - previous_time;
+            previous_time = current_time;
+
+            // A failing stage ends its own thread only, the other stages keep running
+            try
+            {
+                stage.tick(frame_time.count());
+            }
+            catch (const std::exception &e)
+            {
+                Logger::log_error("[StageManager] Stage " + stage.get_guid().to_string() + " shut down after an error: " + e.what());
+                stage.request_shutdown();
+                return;
+            }
+
+            pacer.wait();
+        }
+    }
 }
@@ -0,0 +1,56 @@
+#include "engine/stage/stage_snapshot_ring.h"
+#include "engine/stage/stage.h"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace Engine
+{
+    StageSnapshotRing::StageSnapshotRing(size_t capacity) : slots(capacity)
+    {
+        if (capacity == 0)
+            throw std::runtime_error("StageSnapshotRing needs at least one slot!");
+    }
+
+    void StageSnapshotRing::capture(Stage &stage, uint64_t frame)
+    {
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+
+        Slot &slot = slots[frame % slots.size()];
+        slot.frame = frame;
+
+        stage.get_entity_manager().capture(slot.entities);
+        stage.get_component_manager().capture(slot.components);
+
+        latest_frame = frame;
+
+        std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+        stats.capture_milliseconds = elapsed.count();
+        stats.capture_bytes = slot.entities.get_byte_size() + slot.components.get_byte_size();
+    }
+
+    bool StageSnapshotRing::restore(Stage &stage, uint64_t frame)
+    {
+        if (!contains(frame))
+            return false;
+
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+
+        const Slot &slot = slots[frame % slots.size()];
+
+        stage.get_entity_manager().restore(slot.entities);
+        stage.get_component_manager().restore(slot.components);
+
+        std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+        stats.restore_milliseconds = elapsed.count();
+
+        return true;
+    }
+
+    bool StageSnapshotRing::contains(uint64_t frame) const
+    {
+        return frame != NO_FRAME && slots[frame % slots.size()].frame == frame;
+    }
+}
@@ -0,0 +1,110 @@
+#include "engine/system/system_scheduler.h"
+#include "engine/stage/stage.h"
+#include "engine/jobs/job_system.h"
+#include "engine/component/component_manager.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace Engine
+{
+    void SystemScheduler::run(Stage &stage, float delta_time)
+    {
+        JobSystem *job_system = stage.get_job_system();
+        ComponentManager &component_manager = stage.get_component_manager();
+
+        for (const std::vector<System *> &layer : get_layers())
+        {
+            run_layer(stage, layer, job_system, delta_time);
+
+            // Writes of later layers get a newer tick than anything this layer saw
+            uint32_t tick = component_manager.get_tick();
+            for (System *system : layer)
+                system->last_run_tick = tick;
+
+            component_manager.advance_tick();
+        }
+    }
+
+    void SystemScheduler::run_layer(Stage &stage, const std::vector<System *> &layer, JobSystem *job_system, float delta_time)
+    {
+        if (layer.size() == 1 || !job_system)
+        {
+            for (System *system : layer)
+                system->update(stage, delta_time);
+
+            return;
+        }
+
+        JobCounter counter;
+
+        for (size_t i = 1; i < layer.size(); i++)
+        {
+            System *system = layer[i];
+            job_system->submit([system, &stage, delta_time]()
+                               { system->update(stage, delta_time); },
+                               &counter);
+        }
+
+        std::exception_ptr error;
+
+        try
+        {
+            layer[0]->update(stage, delta_time);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // Waits for the whole layer even if the inline system threw
+        try
+        {
+            job_system->wait(counter);
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    const std::vector<std::vector<System *>> &SystemScheduler::get_layers()
+    {
+        if (schedule_dirty)
+            build_layers();
+
+        return layers;
+    }
+
+    void SystemScheduler::build_layers()
+    {
+        layers.clear();
+
+        std::vector<size_t> system_layers(systems.size(), 0);
+
+        for (size_t i = 0; i < systems.size(); i++)
+        {
+            const SystemAccess &access = systems[i]->get_access();
+
+            size_t layer = 0;
+            for (size_t j = 0; j < i; j++)
+            {
+                if (access.conflicts_with(systems[j]->get_access()))
+                    layer = std::max(layer, system_layers[j] + 1);
+            }
+
+            system_layers[i] = layer;
+
+            if (layer >= layers.size())
+                layers.resize(layer + 1);
+
+            layers[layer].push_back(systems[i].get());
+        }
+
+        schedule_dirty = false;
+    }
+}
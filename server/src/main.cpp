@@ -0,0 +1,45 @@
+#include "engine/runtime/engine_instance.h"
+
+#include "engine/debug/logging/logger.h"
+#include "engine/stage/stage_manager.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> arguments{};
+
+    for (int i = 0; i < argc; i++)
+    {
+        arguments.push_back(argv[i]);
+    }
+
+    Logger::log_info("[Server] Starting...");
+
+    if (arguments.size() < 2)
+    {
+        std::cerr << "Usage: tetra_server <project path> [stage file...]" << std::endl;
+        return 1;
+    }
+
+    Logger::log_info("[Server] Launching project at path \"" + arguments[1] + "\"");
+
+    try
+    {
+        Engine::EngineInstance &instance = Engine::EngineInstance::get_instance();
+        instance.init(arguments[1]);
+
+        // Every stage file runs as a match of its own next to the current stage
+        for (size_t i = 2; i < arguments.size(); i++)
+            Engine::StageManager::get_instance().create_stage(arguments[i]);
+
+        return instance.run(arguments);
+    }
+    catch (const std::exception &e)
+    {
+        Logger::log_error("[Server] Failed to launch project: " + std::string(e.what()));
+        return 1;
+    }
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/3d/camera_3d.h"
+#include "engine/component/3d/transform_3d.h"
+#include "engine/component/3d/transform_propagation.h"
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+#include "engine/math/constants.h"
+#include "engine/stage/stage_manager.h"
+
+using namespace Engine;
+
+class Camera3DTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+};
+
+TEST_F(Camera3DTest, ParentedCameraViewFollowsWorldMatrix)
+{
+    EntityManager &entities = stage->get_entity_manager();
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID rig = entities.create_entity("Rig")->get_id();
+    EntityID camera = entities.create_entity("Camera")->get_id();
+    ASSERT_TRUE(entities.set_parent(camera, rig));
+
+    entities.get_entity_by_id(rig)->add_component<Transform3D>();
+    entities.get_entity_by_id(camera)->add_component<Transform3D>();
+    entities.get_entity_by_id(camera)->add_component<Camera3D>();
+
+    Transform3D *rig_transform = components.get_component<Transform3D>(rig);
+    rig_transform->set_position(Vector3(10.0f, 0.0f, 0.0f));
+    rig_transform->set_rotation(Quaternion::from_axis_angle(Vector3(0.0f, 1.0f, 0.0f), HALF_PI));
+    components.get_component<Transform3D>(camera)->set_position(Vector3(0.0f, 0.0f, 5.0f));
+
+    TransformPropagation propagation;
+    propagation.run(entities, components);
+
+    Graphics::CameraPacket packet;
+    components.read_component<Camera3D>(camera)->extract(*components.read_component<Transform3D>(camera), packet);
+
+    // The rig turns the camera around to face the rig's origin from five units away
+    Vector3 rig_origin = packet.view.transform_point(Vector3(10.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(rig_origin.x, 0.0f, 1e-4f);
+    EXPECT_NEAR(rig_origin.y, 0.0f, 1e-4f);
+    EXPECT_NEAR(rig_origin.z, -5.0f, 1e-4f);
+
+    Vector3 eye = packet.view.transform_point(Vector3(15.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(eye.x, 0.0f, 1e-4f);
+    EXPECT_NEAR(eye.y, 0.0f, 1e-4f);
+    EXPECT_NEAR(eye.z, 0.0f, 1e-4f);
+}
@@ -0,0 +1,561 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+#include "engine/stage/stage_manager.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Engine;
+
+namespace
+{
+    class Health : public Component
+    {
+    public:
+        int value = 100;
+    };
+
+    class Velocity : public Component
+    {
+    public:
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    class Ticker : public Component
+    {
+    public:
+        float elapsed = 0.0f;
+
+        void update(float delta_time) override { elapsed += delta_time; }
+    };
+}
+
+REGISTER_COMPONENT(TestHealth, Health)
+REGISTER_COMPONENT(TestVelocity, Velocity)
+REGISTER_COMPONENT(TestTicker, Ticker)
+
+class ComponentManagerTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    EntityID spawn(const std::string &name)
+    {
+        return stage->get_entity_manager().create_entity(name)->get_id();
+    }
+
+    Entity *entity(EntityID id)
+    {
+        return stage->get_entity_manager().get_entity_by_id(id);
+    }
+};
+
+TEST_F(ComponentManagerTest, AddComponentIsRetrievable)
+{
+    EntityID id = spawn("A");
+
+    Health *health = entity(id)->add_component<Health>();
+    health->value = 42;
+
+    EXPECT_TRUE(entity(id)->has_component<Health>());
+    EXPECT_FALSE(entity(id)->has_component<Velocity>());
+    EXPECT_EQ(entity(id)->get_component<Health>()->value, 42);
+    EXPECT_EQ(entity(id)->get_component<Health>()->get_owner_id(), id);
+    EXPECT_EQ(entity(id)->get_component<Health>()->get_type_id(), component_type_id<Health>());
+}
+
+TEST_F(ComponentManagerTest, MigrationPreservesComponentData)
+{
+    EntityID id = spawn("A");
+
+    entity(id)->add_component<Health>()->value = 7;
+    entity(id)->add_component<Velocity>()->x = 3.0f;
+
+    EXPECT_EQ(entity(id)->get_component<Health>()->value, 7);
+    EXPECT_FLOAT_EQ(entity(id)->get_component<Velocity>()->x, 3.0f);
+}
+
+TEST_F(ComponentManagerTest, EntitiesWithSameTypesShareArchetype)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    for (int i = 0; i < 4; i++)
+    {
+        EntityID id = spawn("E");
+        entity(id)->add_component<Health>();
+        entity(id)->add_component<Velocity>();
+    }
+
+    size_t populated = 0;
+    for (const auto &archetype : components.get_archetypes())
+    {
+        if (archetype->size() > 0)
+        {
+            populated++;
+            EXPECT_EQ(archetype->size(), 4u);
+        }
+    }
+
+    EXPECT_EQ(populated, 1u);
+}
+
+TEST_F(ComponentManagerTest, DuplicateComponentTypeThrows)
+{
+    EntityID id = spawn("A");
+    entity(id)->add_component<Health>();
+
+    EXPECT_THROW(entity(id)->add_component<Health>(), std::runtime_error);
+}
+
+TEST_F(ComponentManagerTest, DestroyComponentKeepsOthers)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    ComponentID health_id = entity(id)->add_component<Health>()->get_id();
+    entity(id)->add_component<Velocity>()->y = 9.0f;
+
+    components.destroy_component(health_id);
+
+    EXPECT_FALSE(entity(id)->has_component<Health>());
+    EXPECT_EQ(components.get_component_by_id(health_id), nullptr);
+    EXPECT_FLOAT_EQ(entity(id)->get_component<Velocity>()->y, 9.0f);
+}
+
+TEST_F(ComponentManagerTest, DestroyEntityRemovesItsComponents)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID first = spawn("First");
+    EntityID second = spawn("Second");
+
+    ComponentID first_health = entity(first)->add_component<Health>()->get_id();
+    entity(second)->add_component<Health>()->value = 11;
+
+    stage->get_entity_manager().destroy_entity(first);
+
+    EXPECT_EQ(components.get_component_by_id(first_health), nullptr);
+    EXPECT_EQ(components.get_components_by_type<Health>().size(), 1u);
+    EXPECT_EQ(entity(second)->get_component<Health>()->value, 11);
+}
+
+TEST_F(ComponentManagerTest, GetComponentsByTypeSpansArchetypes)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID a = spawn("A");
+    EntityID b = spawn("B");
+    EntityID c = spawn("C");
+
+    entity(a)->add_component<Health>();
+    entity(b)->add_component<Health>();
+    entity(b)->add_component<Velocity>();
+    entity(c)->add_component<Velocity>();
+
+    EXPECT_EQ(components.get_components_by_type<Health>().size(), 2u);
+    EXPECT_EQ(components.get_components_by_type<Velocity>().size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, ComponentCreatedEventFires)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    int created = 0;
+    size_t token = components.component_created.subscribe([&](ComponentHandle<Component>)
+                                                          { created++; });
+
+    EntityID id = spawn("A");
+    entity(id)->add_component<Health>();
+    entity(id)->add_component<Velocity>();
+
+    components.component_created.unsubscribe(token);
+
+    EXPECT_EQ(created, 2);
+}
+
+TEST_F(ComponentManagerTest, ForEachComponentVisitsOnlyMatchingType)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    for (int i = 0; i < 5; i++)
+    {
+        EntityID id = spawn("E");
+        entity(id)->add_component<Health>()->value = i;
+        if (i % 2 == 0)
+            entity(id)->add_component<Velocity>();
+    }
+
+    int visited = 0;
+    int sum = 0;
+    components.for_each_component<Health>([&](Health &health)
+                                          {
+        visited++;
+        sum += health.value; });
+
+    EXPECT_EQ(visited, 5);
+    EXPECT_EQ(sum, 0 + 1 + 2 + 3 + 4);
+    EXPECT_EQ(components.get_component_count<Health>(), 5u);
+    EXPECT_EQ(components.get_component_count<Velocity>(), 3u);
+}
+
+TEST_F(ComponentManagerTest, ComponentTypeIsTrackedById)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    ComponentID velocity_id = entity(id)->add_component<Velocity>()->get_id();
+
+    EXPECT_EQ(components.get_component_type(velocity_id), ComponentRegistry::get_instance().get_type_id<Velocity>());
+
+    components.destroy_component(velocity_id);
+
+    EXPECT_EQ(components.get_component_type(velocity_id), INVALID_COMPONENT_TYPE);
+}
+
+TEST_F(ComponentManagerTest, SignatureTracksAddedAndDestroyedComponents)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    EXPECT_TRUE(components.get_signature(id).none());
+
+    ComponentID health_id = entity(id)->add_component<Health>()->get_id();
+    entity(id)->add_component<Velocity>();
+
+    ComponentSignature signature = components.get_signature(id);
+    EXPECT_TRUE(signature.test(component_type_id<Health>()));
+    EXPECT_TRUE(signature.test(component_type_id<Velocity>()));
+
+    components.destroy_component(health_id);
+
+    EXPECT_FALSE(components.has_component<Health>(id));
+    EXPECT_TRUE(components.has_component<Velocity>(id));
+    EXPECT_EQ(components.get_signature(id).count(), 1u);
+}
+
+TEST_F(ComponentManagerTest, GetEntitiesWithMatchesAllRequiredTypes)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID health_only = spawn("HealthOnly");
+    EntityID both = spawn("Both");
+    EntityID velocity_only = spawn("VelocityOnly");
+
+    entity(health_only)->add_component<Health>();
+    entity(both)->add_component<Health>();
+    entity(both)->add_component<Velocity>();
+    entity(velocity_only)->add_component<Velocity>();
+
+    std::vector<EntityID> with_both = components.get_entities_with<Health, Velocity>();
+    ASSERT_EQ(with_both.size(), 1u);
+    EXPECT_EQ(with_both[0], both);
+
+    EXPECT_EQ(components.get_entities_with<Health>().size(), 2u);
+    EXPECT_EQ(components.get_entities_with<Velocity>().size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, ViewYieldsTypedComponentsOfMatchingEntities)
+{
+    EntityID moving = spawn("Moving");
+    EntityID idle = spawn("Idle");
+
+    entity(moving)->add_component<Health>()->value = 5;
+    entity(moving)->add_component<Velocity>()->x = 2.0f;
+    entity(idle)->add_component<Health>();
+
+    size_t visited = 0;
+    for (auto [id, health, velocity] : stage->view<Health, Velocity>())
+    {
+        EXPECT_EQ(id, moving);
+        EXPECT_EQ(health.value, 5);
+        EXPECT_FLOAT_EQ(velocity.x, 2.0f);
+        visited++;
+    }
+
+    EXPECT_EQ(visited, 1u);
+    EXPECT_EQ(stage->view<Health>().size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, ViewCacheFollowsNewArchetypes)
+{
+    EntityID first = spawn("First");
+    entity(first)->add_component<Velocity>();
+
+    EXPECT_TRUE((stage->view<Health, Velocity>().empty()));
+
+    // Creates the Health + Velocity archetype after the query has been cached
+    EntityID second = spawn("Second");
+    entity(second)->add_component<Health>();
+    entity(second)->add_component<Velocity>()->y = 3.0f;
+
+    float sum = 0.0f;
+    stage->view<Health, Velocity>().each([&](EntityID id, Health &, Velocity &velocity)
+                                         {
+                                             EXPECT_EQ(id, second);
+                                             sum += velocity.y; });
+
+    EXPECT_FLOAT_EQ(sum, 3.0f);
+    EXPECT_EQ(stage->view<Velocity>().size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, CreateEntitiesBuildsComponentsInOneBatch)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    size_t batch_events = 0;
+    size_t single_events = 0;
+    components.components_created_batch.subscribe([&](const ComponentManager::ComponentBatch &batch)
+                                                  {
+                                                      batch_events++;
+                                                      EXPECT_EQ(batch.count, 1000u); });
+    components.component_created.subscribe([&](ComponentHandle<Component>)
+                                           { single_events++; });
+
+    std::vector<EntityID> ids;
+    stage->get_entity_manager().create_entities<Health, Velocity>(1000, ids);
+
+    ASSERT_EQ(ids.size(), 1000u);
+    EXPECT_EQ(batch_events, 1u);
+    EXPECT_EQ(single_events, 0u);
+    EXPECT_EQ((stage->view<Health, Velocity>().size()), 1000u);
+
+    Health *health = entity(ids[500])->get_component<Health>();
+    ASSERT_NE(health, nullptr);
+    EXPECT_EQ(health->value, 100);
+    EXPECT_EQ(health->get_owner_id(), ids[500]);
+    EXPECT_EQ(components.get_component_by_id(health->get_id()), health);
+
+    // Bulk created entities behave like any other
+    stage->get_entity_manager().destroy_entity(ids[0]);
+    EXPECT_EQ(components.get_component_count<Health>(), 999u);
+}
+
+TEST_F(ComponentManagerTest, OnlyTypesOverridingUpdateAreBatched)
+{
+    const std::vector<ComponentTypeID> &update_types = ComponentRegistry::get_instance().get_update_types();
+
+    auto contains = [&](ComponentTypeID type_id)
+    { return std::find(update_types.begin(), update_types.end(), type_id) != update_types.end(); };
+
+    EXPECT_TRUE(contains(component_type_id<Ticker>()));
+    EXPECT_FALSE(contains(component_type_id<Health>()));
+    EXPECT_FALSE(contains(component_type_id<Velocity>()));
+}
+
+TEST_F(ComponentManagerTest, TypeBatchedUpdateReachesEveryArchetype)
+{
+    std::vector<EntityID> plain;
+    std::vector<EntityID> with_health;
+    stage->get_entity_manager().create_entities<Ticker>(10, plain);
+    stage->get_entity_manager().create_entities<Ticker, Health>(5, with_health);
+
+    stage->set_update_mode(ComponentUpdateMode::TypeBatched);
+    stage->update(0.25f);
+    stage->update(0.25f);
+
+    size_t visited = 0;
+    stage->view<Ticker>().each([&](EntityID, Ticker &ticker)
+                               {
+                                   EXPECT_FLOAT_EQ(ticker.elapsed, 0.5f);
+                                   visited++; });
+
+    EXPECT_EQ(visited, 15u);
+}
+
+TEST_F(ComponentManagerTest, HandleSurvivesArchetypeMovesAndExpires)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    entity(id)->add_component<Health>()->value = 33;
+
+    ComponentHandle<Health> handle = entity(id)->get_component_handle<Health>();
+    ASSERT_TRUE(handle.is_valid());
+
+    // Moves the Health component into another archetype
+    entity(id)->add_component<Velocity>();
+
+    Health *health = components.resolve(handle);
+    ASSERT_NE(health, nullptr);
+    EXPECT_EQ(health->value, 33);
+
+    ComponentHandle<Component> erased = handle;
+    EXPECT_EQ(handle_cast<Health>(erased), handle);
+    EXPECT_FALSE(handle_cast<Velocity>(erased).is_valid());
+
+    components.destroy_component(handle.id);
+    EXPECT_EQ(components.resolve(handle), nullptr);
+}
+
+TEST_F(ComponentManagerTest, DestroyedEventHandleResolvesInsideCallback)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    entity(id)->add_component<Health>()->value = 8;
+
+    int seen_value = 0;
+    components.component_destroyed.subscribe([&](ComponentHandle<Component> handle)
+                                             {
+                                                 if (Health *health = components.resolve(handle_cast<Health>(handle)))
+                                                     seen_value = health->value; });
+
+    stage->get_entity_manager().destroy_entity(id);
+
+    EXPECT_EQ(seen_value, 8);
+}
+
+TEST_F(ComponentManagerTest, AddedSinceFiltersByCreationTick)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID old_entity = spawn("Old");
+    entity(old_entity)->add_component<Health>();
+
+    uint32_t tick = components.get_tick();
+    components.advance_tick();
+
+    EntityID new_entity = spawn("New");
+    entity(new_entity)->add_component<Health>();
+
+    std::vector<EntityID> added;
+    for (auto [id, health] : stage->view<const Health>().added_since<Health>(tick))
+        added.push_back(id);
+
+    ASSERT_EQ(added.size(), 1u);
+    EXPECT_EQ(added[0], new_entity);
+    EXPECT_EQ(stage->view<const Health>().size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, MutableAccessMarksChangedAndSurvivesMoves)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID a = spawn("A");
+    EntityID b = spawn("B");
+    entity(a)->add_component<Health>();
+    entity(b)->add_component<Health>();
+
+    uint32_t tick = components.get_tick();
+    components.advance_tick();
+
+    EXPECT_TRUE((stage->view<const Health>().changed_since<Health>(tick).empty()));
+
+    components.get_component<Health>(a)->value = 1;
+    components.read_component<Health>(b);
+
+    // Moving A's Health into another archetype keeps its ticks
+    entity(a)->add_component<Velocity>();
+
+    size_t visited = 0;
+    stage->view<const Health>().changed_since<Health>(tick).each([&](EntityID id, const Health &health)
+                                                                {
+                                                                    EXPECT_EQ(id, a);
+                                                                    EXPECT_EQ(health.value, 1);
+                                                                    visited++; });
+    EXPECT_EQ(visited, 1u);
+
+    // Iterating a non-const view marks every visited row
+    components.advance_tick();
+    uint32_t before_write = components.get_tick() - 1;
+    for (auto [id, health] : stage->view<Health>())
+        health.value++;
+
+    EXPECT_EQ(stage->view<const Health>().changed_since<Health>(before_write).size(), 2u);
+}
+
+TEST_F(ComponentManagerTest, ConstReadsDoNotMarkChanged)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("A");
+    entity(id)->add_component<Health>()->value = 7;
+    ComponentHandle<Health> handle = entity(id)->get_component_handle<Health>();
+
+    uint32_t tick = components.get_tick();
+    components.advance_tick();
+
+    const Entity *reader = entity(id);
+    EXPECT_EQ(reader->get_component<Health>()->value, 7);
+    EXPECT_EQ(components.read_component(handle)->value, 7);
+    EXPECT_TRUE((stage->view<const Health>().changed_since<Health>(tick).empty()));
+
+    components.destroy_component(handle.id);
+    EXPECT_EQ(components.read_component(handle), nullptr);
+}
+
+TEST_F(ComponentManagerTest, TickFiltersSurviveCounterWraparound)
+{
+    ComponentManager &components = stage->get_component_manager();
+
+    EntityID id = spawn("Wrapped");
+    entity(id)->add_component<Health>();
+
+    // A reader that last ran just before the counter wrapped still sees rows stamped after it
+    uint32_t before_wrap = std::numeric_limits<uint32_t>::max() - 1;
+    EXPECT_EQ(stage->view<const Health>().added_since<Health>(before_wrap).size(), 1u);
+
+    components.advance_tick();
+    components.get_component<Health>(id)->value = 3;
+    EXPECT_EQ(stage->view<const Health>().changed_since<Health>(before_wrap).size(), 1u);
+
+    // Rows stamped before the filter tick stay filtered out
+    EXPECT_TRUE((stage->view<const Health>().added_since<Health>(components.get_tick()).empty()));
+}
+
+TEST_F(ComponentManagerTest, ViewsAndBatchedUpdateSkipInactive)
+{
+    std::vector<EntityID> tickers;
+    stage->get_entity_manager().create_entities<Ticker>(4, tickers);
+
+    EntityID parent = spawn("Parent");
+    stage->get_entity_manager().set_parent(tickers[1], parent);
+
+    entity(parent)->set_enabled(false);
+    entity(tickers[2])->set_enabled(false);
+    stage->get_component_manager().get_component<Ticker>(tickers[3])->set_enabled(false);
+
+    // Views skip the disabled Ticker too unless asked to include it
+    EXPECT_EQ(stage->view<const Ticker>().size(), 1u);
+    EXPECT_EQ(stage->view<const Ticker>().include_disabled().size(), 2u);
+    EXPECT_EQ(stage->view<const Ticker>().include_inactive().size(), 3u);
+    EXPECT_EQ(stage->view<const Ticker>().include_inactive().include_disabled().size(), 4u);
+
+    size_t visited = 0;
+    for (auto [id, ticker] : stage->view<const Ticker>())
+    {
+        EXPECT_EQ(id, tickers[0]);
+        visited++;
+    }
+    EXPECT_EQ(visited, 1u);
+
+    stage->set_update_mode(ComponentUpdateMode::TypeBatched);
+    stage->update(0.5f);
+
+    ComponentManager &components = stage->get_component_manager();
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[0])->elapsed, 0.5f);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[1])->elapsed, 0.0f);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[2])->elapsed, 0.0f);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[3])->elapsed, 0.0f);
+
+    // Reactivating moves the rows back into the active range with their data intact
+    entity(parent)->set_enabled(true);
+    components.get_component<Ticker>(tickers[3])->set_enabled(true);
+    stage->update(0.5f);
+
+    EXPECT_EQ(stage->view<const Ticker>().size(), 3u);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[0])->elapsed, 1.0f);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[1])->elapsed, 0.5f);
+    EXPECT_FLOAT_EQ(components.read_component<Ticker>(tickers[3])->elapsed, 0.5f);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_registry.h"
+#include "engine/component/component_type.h"
+
+using namespace Engine;
+
+namespace
+{
+    class Armor : public Component
+    {
+    public:
+        int value = 10;
+    };
+
+    class Shield : public Component
+    {
+    };
+
+    class Unregistered : public Component
+    {
+    };
+}
+
+REGISTER_COMPONENT(TestArmor, Armor)
+REGISTER_COMPONENT(TestShield, Shield)
+
+TEST(ComponentRegistryTest, RegisteredTypesGetDistinctDenseIds)
+{
+    ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+    ComponentTypeID armor = component_type_id<Armor>();
+    ComponentTypeID shield = component_type_id<Shield>();
+
+    ASSERT_NE(armor, INVALID_COMPONENT_TYPE);
+    ASSERT_NE(shield, INVALID_COMPONENT_TYPE);
+    EXPECT_NE(armor, shield);
+    EXPECT_LT(armor, registry.get_type_count());
+    EXPECT_LT(shield, registry.get_type_count());
+
+    EXPECT_EQ(registry.get_type_id("TestArmor"), armor);
+    EXPECT_EQ(registry.get_type_name(shield), "TestShield");
+    EXPECT_EQ(component_type_id<Unregistered>(), INVALID_COMPONENT_TYPE);
+}
+
+TEST(ComponentRegistryTest, RegisteringAgainKeepsTheSameId)
+{
+    ComponentRegistry &registry = ComponentRegistry::get_instance();
+
+    size_t type_count = registry.get_type_count();
+    ComponentTypeID armor = registry.register_type<Armor>("TestArmor");
+
+    EXPECT_EQ(armor, component_type_id<Armor>());
+    EXPECT_EQ(registry.get_type_count(), type_count);
+}
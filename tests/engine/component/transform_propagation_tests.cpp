@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/3d/transform_3d.h"
+#include "engine/component/3d/transform_propagation.h"
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+#include "engine/stage/stage_manager.h"
+
+using namespace Engine;
+
+class TransformPropagationTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+    TransformPropagation propagation;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    Transform3D *spawn(const std::string &name, EntityID &out_id)
+    {
+        Entity *entity = stage->get_entity_manager().create_entity(name);
+        out_id = entity->get_id();
+        return entity->add_component<Transform3D>();
+    }
+
+    Transform3D *transform(EntityID id)
+    {
+        return stage->get_component_manager().get_component<Transform3D>(id);
+    }
+
+    void propagate()
+    {
+        propagation.run(stage->get_entity_manager(), stage->get_component_manager());
+    }
+
+    static Vector3 world_position(const Transform3D &transform)
+    {
+        return transform.get_world_matrix().transform_point(Vector3(0.0f, 0.0f, 0.0f));
+    }
+};
+
+TEST_F(TransformPropagationTest, ChildWorldMatrixComposesParent)
+{
+    EntityID parent, child;
+    spawn("Parent", parent)->set_position(Vector3(1.0f, 2.0f, 3.0f));
+    spawn("Child", child)->set_position(Vector3(10.0f, 0.0f, 0.0f));
+
+    ASSERT_TRUE(stage->get_entity_manager().set_parent(child, parent));
+
+    propagate();
+
+    Vector3 position = world_position(*transform(child));
+    EXPECT_FLOAT_EQ(position.x, 11.0f);
+    EXPECT_FLOAT_EQ(position.y, 2.0f);
+    EXPECT_FLOAT_EQ(position.z, 3.0f);
+
+    EXPECT_FALSE(transform(parent)->is_dirty());
+    EXPECT_FALSE(transform(child)->is_dirty());
+}
+
+TEST_F(TransformPropagationTest, MovingParentUpdatesDescendants)
+{
+    EntityID root, middle, leaf;
+    spawn("Root", root);
+    spawn("Middle", middle)->set_position(Vector3(0.0f, 1.0f, 0.0f));
+    spawn("Leaf", leaf)->set_position(Vector3(0.0f, 1.0f, 0.0f));
+
+    stage->get_entity_manager().set_parent(middle, root);
+    stage->get_entity_manager().set_parent(leaf, middle);
+
+    propagate();
+    EXPECT_FLOAT_EQ(world_position(*transform(leaf)).y, 2.0f);
+
+    transform(root)->translate(Vector3(0.0f, 5.0f, 0.0f));
+    EXPECT_TRUE(transform(root)->is_dirty());
+    EXPECT_FALSE(transform(leaf)->is_dirty());
+
+    propagate();
+    EXPECT_FLOAT_EQ(world_position(*transform(leaf)).y, 7.0f);
+}
+
+TEST_F(TransformPropagationTest, EntityWithoutTransformPassesParentThrough)
+{
+    EntityID root, child;
+    spawn("Root", root)->set_position(Vector3(4.0f, 0.0f, 0.0f));
+
+    EntityID group = stage->get_entity_manager().create_entity("Group")->get_id();
+    spawn("Child", child);
+
+    stage->get_entity_manager().set_parent(group, root);
+    stage->get_entity_manager().set_parent(child, group);
+
+    propagate();
+
+    EXPECT_FLOAT_EQ(world_position(*transform(child)).x, 4.0f);
+}
+
+TEST_F(TransformPropagationTest, ReparentingRecomputesWorldMatrix)
+{
+    EntityID a, b, child;
+    spawn("A", a)->set_position(Vector3(1.0f, 0.0f, 0.0f));
+    spawn("B", b)->set_position(Vector3(-1.0f, 0.0f, 0.0f));
+    spawn("Child", child);
+
+    stage->get_entity_manager().set_parent(child, a);
+    propagate();
+    EXPECT_FLOAT_EQ(world_position(*transform(child)).x, 1.0f);
+
+    stage->get_entity_manager().set_parent(child, b);
+    propagate();
+    EXPECT_FLOAT_EQ(world_position(*transform(child)).x, -1.0f);
+}
+
+TEST_F(TransformPropagationTest, OnlyChangedSubtreesAreVisited)
+{
+    EntityID prop, prop_child;
+    spawn("Prop", prop);
+    spawn("PropChild", prop_child);
+    stage->get_entity_manager().set_parent(prop_child, prop);
+
+    for (int i = 0; i < 20; i++)
+    {
+        EntityID still;
+        spawn("Still", still);
+    }
+
+    propagate();
+
+    // Propagation only reads transforms, so only the explicit fetch marks one changed
+    ComponentManager &components = stage->get_component_manager();
+    uint32_t before = components.advance_tick();
+    components.advance_tick();
+
+    Transform3D *moving = components.get_component<Transform3D>(prop);
+    uint32_t after_fetch = components.get_tick();
+    components.advance_tick();
+
+    propagate();
+    EXPECT_EQ(components.view<const Transform3D>().changed_since<const Transform3D>(after_fetch).size(), 0u);
+
+    // A pointer held across frames still reaches propagation through mark_dirty
+    moving->set_position(Vector3(0.0f, 3.0f, 0.0f));
+    propagate();
+
+    EXPECT_FLOAT_EQ(world_position(*components.read_component<Transform3D>(prop_child)).y, 3.0f);
+    EXPECT_EQ(components.view<const Transform3D>().changed_since<const Transform3D>(after_fetch).size(), 0u);
+    EXPECT_EQ(components.view<const Transform3D>().changed_since<const Transform3D>(before).size(), 1u);
+
+    // Reparenting rebuilds every world matrix without marking any transform changed
+    stage->get_entity_manager().set_parent(prop_child, EntityID::Invalid);
+    propagate();
+    EXPECT_EQ(components.view<const Transform3D>().changed_since<const Transform3D>(after_fetch).size(), 0u);
+}
+
+TEST_F(TransformPropagationTest, AddedTransformComposesExistingParent)
+{
+    EntityID parent, child;
+    spawn("Parent", parent)->set_position(Vector3(0.0f, 0.0f, 2.0f));
+
+    child = stage->get_entity_manager().create_entity("Child")->get_id();
+    stage->get_entity_manager().set_parent(child, parent);
+
+    propagate();
+    stage->get_component_manager().advance_tick();
+
+    // No parent link changes here, the new transform is recorded when it is attached
+    stage->get_entity_manager().get_entity_by_id(child)->add_component<Transform3D>()->set_position(Vector3(1.0f, 0.0f, 0.0f));
+    propagate();
+
+    Vector3 position = world_position(*transform(child));
+    EXPECT_FLOAT_EQ(position.x, 1.0f);
+    EXPECT_FLOAT_EQ(position.z, 2.0f);
+}
+
+TEST(Transform3DTest, CachedBasisMatchesQuaternionRotation)
+{
+    Transform3D transform;
+    transform.set_rotation(Quaternion::from_axis_angle(Vector3(0.0f, 1.0f, 0.0f), HALF_PI));
+
+    Quaternion q = transform.get_rotation();
+    Vector3 expected_forward = q * Vector3(0.0f, 0.0f, -1.0f);
+    Vector3 expected_right = q * Vector3(1.0f, 0.0f, 0.0f);
+
+    Vector3 forward = transform.get_forward();
+    Vector3 right = transform.get_right();
+
+    EXPECT_NEAR(forward.x, expected_forward.x, 1e-5f);
+    EXPECT_NEAR(forward.y, expected_forward.y, 1e-5f);
+    EXPECT_NEAR(forward.z, expected_forward.z, 1e-5f);
+    EXPECT_NEAR(right.x, expected_right.x, 1e-5f);
+    EXPECT_NEAR(right.z, expected_right.z, 1e-5f);
+
+    EXPECT_NEAR(transform.get_up().y, 1.0f, 1e-5f);
+}
+
+TEST(Transform3DTest, RotateDegreesConvertsToRadians)
+{
+    Transform3D transform;
+    transform.rotate_degrees(Vector3(0.0f, 90.0f, 0.0f));
+
+    EXPECT_NEAR(transform.get_rotation_radians().y, HALF_PI, 1e-5f);
+    EXPECT_TRUE(transform.is_dirty());
+
+    Vector3 forward = transform.get_forward();
+    EXPECT_NEAR(std::abs(forward.x), 1.0f, 1e-5f);
+    EXPECT_NEAR(forward.z, 0.0f, 1e-5f);
+}
+
+TEST(Transform3DTest, RotateDegreesComposesOntoTheCurrentRotation)
+{
+    Transform3D transform;
+    transform.set_rotation(Quaternion::from_axis_angle(Vector3(1.0f, 0.0f, 0.0f), HALF_PI));
+    transform.rotate_degrees(Vector3(0.0f, 90.0f, 0.0f));
+
+    Quaternion expected = Quaternion::from_axis_angle(Vector3(0.0f, 1.0f, 0.0f), HALF_PI) *
+                          Quaternion::from_axis_angle(Vector3(1.0f, 0.0f, 0.0f), HALF_PI);
+
+    Vector3 probe(0.3f, -0.5f, 0.8f);
+    Vector3 actual = transform.get_rotation() * probe;
+    Vector3 wanted = expected * probe;
+    EXPECT_NEAR(actual.x, wanted.x, 1e-5f);
+    EXPECT_NEAR(actual.y, wanted.y, 1e-5f);
+    EXPECT_NEAR(actual.z, wanted.z, 1e-5f);
+}
+
+TEST(Transform3DTest, BatchLocalMatricesMatchPerObject)
+{
+    std::vector<Transform3D> transforms(11);
+    for (size_t i = 0; i < transforms.size(); i++)
+    {
+        float f = static_cast<float>(i);
+        transforms[i].set_position(Vector3(f, 1.0f, -f));
+        transforms[i].rotate_degrees(Vector3(10.0f * f, 5.0f, 0.0f));
+        transforms[i].set_scale(Vector3(1.0f + f, 1.0f, 0.5f));
+    }
+
+    std::vector<Matrix4> batched(transforms.size());
+    Transform3D::compute_local_matrices(transforms.data(), transforms.size(), batched.data());
+
+    for (size_t i = 0; i < transforms.size(); i++)
+        EXPECT_TRUE(batched[i].equals_eps(transforms[i].get_local_matrix(), 1e-5f)) << "index " << i;
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include "engine/data/string_table.h"
+
+using namespace Engine;
+
+TEST(StringTableTest, InterningIsIdempotentAndStable)
+{
+    StringTable table;
+
+    StringID player = table.intern("Player");
+    const std::string *stored = &table.get(player);
+
+    for (int i = 0; i < 1000; i++)
+        table.intern("Name" + std::to_string(i));
+
+    EXPECT_EQ(table.intern(std::string("Player")), player);
+    EXPECT_EQ(&table.get(player), stored);
+    EXPECT_EQ(table.get(player), "Player");
+    EXPECT_EQ(table.size(), 1001u);
+}
+
+TEST(StringTableTest, FindDoesNotIntern)
+{
+    StringTable table;
+    table.intern("Known");
+
+    EXPECT_EQ(table.find("Unknown"), StringTable::INVALID_STRING);
+    EXPECT_EQ(table.find("Known"), 0u);
+    EXPECT_EQ(table.size(), 1u);
+}
@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+
+using namespace Engine;
+
+TEST(EntityManagerTest, CreateEntityIsRetrievable)
+{
+    EntityManager manager(nullptr);
+
+    Entity *entity = manager.create_entity("Player");
+    EntityID id = entity->get_id();
+
+    EXPECT_TRUE(manager.has_entity(id));
+    EXPECT_EQ(manager.get_entity_by_id(id)->get_name(), "Player");
+    EXPECT_EQ(manager.get_entity_count(), 1u);
+}
+
+TEST(EntityManagerTest, DestroyInvalidatesId)
+{
+    EntityManager manager(nullptr);
+
+    EntityID id = manager.create_entity("A")->get_id();
+    manager.destroy_entity(id);
+
+    EXPECT_FALSE(manager.has_entity(id));
+    EXPECT_EQ(manager.get_entity_by_id(id), nullptr);
+    EXPECT_EQ(manager.get_entity_count(), 0u);
+}
+
+TEST(EntityManagerTest, ReusedIndexGetsNewGeneration)
+{
+    EntityManager manager(nullptr);
+
+    EntityID old_id = manager.create_entity("A")->get_id();
+    manager.destroy_entity(old_id);
+
+    EntityID new_id = manager.create_entity("B")->get_id();
+
+    EXPECT_EQ(new_id.index, old_id.index);
+    EXPECT_NE(new_id.generation, old_id.generation);
+    EXPECT_FALSE(manager.has_entity(old_id));
+    EXPECT_TRUE(manager.has_entity(new_id));
+}
+
+TEST(EntityManagerTest, DestroyKeepsRemainingEntitiesAddressable)
+{
+    EntityManager manager(nullptr);
+
+    std::vector<EntityID> ids;
+    for (int i = 0; i < 8; i++)
+        ids.push_back(manager.create_entity("E" + std::to_string(i))->get_id());
+
+    manager.destroy_entity(ids[2]);
+    manager.destroy_entity(ids[0]);
+
+    EXPECT_EQ(manager.get_entity_count(), 6u);
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (i == 0 || i == 2)
+            continue;
+
+        Entity *entity = manager.get_entity_by_id(ids[i]);
+        ASSERT_NE(entity, nullptr);
+        EXPECT_EQ(entity->get_id(), ids[i]);
+        EXPECT_EQ(entity->get_name(), "E" + std::to_string(i));
+    }
+}
+
+TEST(EntityManagerTest, DestroyingStaleIdIsNoOp)
+{
+    EntityManager manager(nullptr);
+
+    EntityID id = manager.create_entity("A")->get_id();
+    manager.destroy_entity(id);
+    EntityID reused = manager.create_entity("B")->get_id();
+
+    manager.destroy_entity(id);
+
+    EXPECT_TRUE(manager.has_entity(reused));
+    EXPECT_EQ(manager.get_entity_count(), 1u);
+}
+
+TEST(EntityManagerTest, CreateEntitiesReusesFreedIndices)
+{
+    EntityManager manager(nullptr);
+
+    EntityID freed = manager.create_entity("Freed")->get_id();
+    manager.destroy_entity(freed);
+
+    std::vector<EntityID> ids;
+    manager.create_entities(3, ComponentSignature(), ids, "Agent");
+
+    ASSERT_EQ(ids.size(), 3u);
+    EXPECT_EQ(ids[0].index, freed.index);
+    EXPECT_NE(ids[0].generation, freed.generation);
+
+    for (EntityID id : ids)
+    {
+        ASSERT_TRUE(manager.has_entity(id));
+        EXPECT_EQ(manager.get_entity_by_id(id)->get_name(), "Agent");
+    }
+
+    EXPECT_EQ(manager.get_entity_count(), 3u);
+}
+
+TEST(EntityManagerTest, HierarchyIsBreadthFirstWithParentIndices)
+{
+    EntityManager manager(nullptr);
+
+    EntityID leaf = manager.create_entity("Leaf")->get_id();
+    EntityID child = manager.create_entity("Child")->get_id();
+    EntityID root = manager.create_entity("Root")->get_id();
+    EntityID sibling = manager.create_entity("Sibling")->get_id();
+
+    ASSERT_TRUE(manager.set_parent(leaf, child));
+    ASSERT_TRUE(manager.set_parent(child, root));
+    ASSERT_TRUE(manager.set_parent(sibling, root));
+
+    const EntityHierarchy &hierarchy = manager.get_hierarchy();
+    const std::vector<EntityID> &order = hierarchy.get_order();
+    const std::vector<uint32_t> &parents = hierarchy.get_parent_indices();
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[0], root);
+    EXPECT_EQ(parents[0], EntityHierarchy::NO_PARENT);
+
+    for (size_t i = 1; i < order.size(); i++)
+    {
+        ASSERT_LT(parents[i], i);
+        EXPECT_EQ(manager.get_entity_by_id(order[i])->get_parent()->get_id(), order[parents[i]]);
+        EXPECT_GE(hierarchy.get_depths()[i], hierarchy.get_depths()[i - 1]);
+    }
+
+    EXPECT_EQ(order.back(), leaf);
+    EXPECT_EQ(hierarchy.get_depths().back(), 2u);
+}
+
+TEST(EntityManagerTest, CollectDescendantsReturnsOnlyTheSubtree)
+{
+    EntityManager manager(nullptr);
+
+    EntityID root = manager.create_entity("Root")->get_id();
+    EntityID child = manager.create_entity("Child")->get_id();
+    EntityID leaf = manager.create_entity("Leaf")->get_id();
+    EntityID sibling = manager.create_entity("Sibling")->get_id();
+    EntityID other = manager.create_entity("Other")->get_id();
+    EntityID outside = manager.create_entity("Outside")->get_id();
+
+    ASSERT_TRUE(manager.set_parent(leaf, child));
+    ASSERT_TRUE(manager.set_parent(child, root));
+    ASSERT_TRUE(manager.set_parent(sibling, root));
+    ASSERT_TRUE(manager.set_parent(outside, other));
+
+    std::vector<EntityID> descendants;
+    manager.collect_descendants(root, descendants);
+
+    // Breadth-first, so every parent precedes its children
+    ASSERT_EQ(descendants.size(), 3u);
+    EXPECT_EQ(descendants[0], child);
+    EXPECT_EQ(descendants[1], sibling);
+    EXPECT_EQ(descendants[2], leaf);
+
+    descendants.clear();
+    manager.collect_descendants(leaf, descendants);
+    EXPECT_TRUE(descendants.empty());
+}
+
+TEST(EntityManagerTest, SetParentRejectsCycles)
+{
+    EntityManager manager(nullptr);
+
+    EntityID a = manager.create_entity("A")->get_id();
+    EntityID b = manager.create_entity("B")->get_id();
+    EntityID c = manager.create_entity("C")->get_id();
+
+    ASSERT_TRUE(manager.set_parent(b, a));
+    ASSERT_TRUE(manager.set_parent(c, b));
+
+    EXPECT_FALSE(manager.set_parent(a, c));
+    EXPECT_FALSE(manager.set_parent(a, a));
+    EXPECT_EQ(manager.get_entity_by_id(a)->get_parent(), nullptr);
+
+    ASSERT_TRUE(manager.set_parent(c, a));
+    EXPECT_EQ(manager.get_entity_by_id(b)->get_children().size(), 0u);
+    EXPECT_EQ(manager.get_entity_by_id(a)->get_children().size(), 2u);
+}
+
+TEST(EntityManagerTest, DestroyRemovesWholeSubtree)
+{
+    EntityManager manager(nullptr);
+
+    EntityID keep = manager.create_entity("Keep")->get_id();
+    EntityID root = manager.create_entity("Root")->get_id();
+
+    EntityID parent = root;
+    for (int i = 0; i < 64; i++)
+    {
+        EntityID node = manager.create_entity("Node")->get_id();
+        manager.set_parent(node, parent);
+        parent = node;
+    }
+
+    ASSERT_TRUE(manager.set_parent(root, keep));
+
+    manager.destroy_entity(root);
+
+    EXPECT_EQ(manager.get_entity_count(), 1u);
+    EXPECT_TRUE(manager.has_entity(keep));
+    EXPECT_TRUE(manager.get_entity_by_id(keep)->get_children().empty());
+    EXPECT_EQ(manager.get_hierarchy().size(), 1u);
+}
+
+TEST(EntityManagerTest, DisablingParentDeactivatesSubtree)
+{
+    EntityManager manager(nullptr);
+
+    EntityID root = manager.create_entity("Root")->get_id();
+    EntityID child = manager.create_entity("Child")->get_id();
+    EntityID leaf = manager.create_entity("Leaf")->get_id();
+    EntityID other = manager.create_entity("Other")->get_id();
+
+    manager.set_parent(child, root);
+    manager.set_parent(leaf, child);
+
+    manager.set_enabled(child, false);
+    EXPECT_EQ(manager.get_active_count(), 2u);
+    EXPECT_FALSE(manager.get_entity_by_id(child)->is_active());
+    EXPECT_FALSE(manager.get_entity_by_id(leaf)->is_active());
+    EXPECT_TRUE(manager.get_entity_by_id(leaf)->is_enabled());
+
+    // Disabling an ancestor keeps the child's own flag, re-enabling restores only what was enabled
+    manager.set_enabled(root, false);
+    manager.set_enabled(child, true);
+    EXPECT_EQ(manager.get_active_count(), 1u);
+    EXPECT_FALSE(manager.get_entity_by_id(child)->is_active());
+
+    manager.set_enabled(root, true);
+    EXPECT_EQ(manager.get_active_count(), 4u);
+
+    // Active entities stay in front of the dense array
+    manager.set_enabled(other, false);
+    for (size_t i = 0; i < manager.get_entity_count(); i++)
+        EXPECT_EQ(manager.get_entities()[i].is_active(), i < manager.get_active_count());
+
+    // Moving an entity under a disabled parent deactivates it, destroying keeps the count in sync
+    manager.set_parent(root, other);
+    EXPECT_EQ(manager.get_active_count(), 0u);
+
+    manager.destroy_entity(child);
+    manager.set_enabled(other, true);
+    EXPECT_EQ(manager.get_active_count(), 2u);
+    EXPECT_EQ(manager.get_entity_count(), 2u);
+}
+
+TEST(EntityManagerTest, NameIndexFollowsCreateRenameAndDestroy)
+{
+    EntityManager manager(nullptr);
+
+    std::vector<EntityID> points;
+    manager.create_entities(3, ComponentSignature(), points, "Point");
+    EntityID other = manager.create_entity("Other")->get_id();
+
+    EXPECT_EQ(manager.find_entities("Point").size(), 3u);
+    EXPECT_EQ(manager.find_entities("Missing").size(), 0u);
+
+    Entity *renamed = manager.get_entity_by_id(points[0]);
+    renamed->set_name("Spawner");
+    EXPECT_EQ(renamed->get_name(), "Spawner");
+    EXPECT_EQ(manager.find_entity("Spawner")->get_id(), points[0]);
+    EXPECT_EQ(manager.find_entities("Point").size(), 2u);
+
+    manager.destroy_entity(points[1]);
+    ASSERT_EQ(manager.find_entities("Point").size(), 1u);
+    EXPECT_EQ(manager.find_entities("Point")[0], points[2]);
+
+    // Names share one interned entry
+    EXPECT_EQ(manager.get_entity_by_id(points[2])->get_name_id(), manager.get_name_table().find("Point"));
+    EXPECT_EQ(manager.find_entity("Other")->get_id(), other);
+}
+
+TEST(EntityManagerTest, PathLookupWalksFromRoot)
+{
+    EntityManager manager(nullptr);
+
+    EntityID level = manager.create_entity("Level")->get_id();
+    EntityID spawner = manager.create_entity("Spawner")->get_id();
+    EntityID point = manager.create_entity("Point03")->get_id();
+    EntityID decoy = manager.create_entity("Point03")->get_id();
+    EntityID orphan = manager.create_entity("Spawner")->get_id();
+
+    manager.set_parent(spawner, level);
+    manager.set_parent(point, spawner);
+    manager.set_parent(decoy, orphan);
+
+    ASSERT_NE(manager.find_entity_by_path("Level/Spawner/Point03"), nullptr);
+    EXPECT_EQ(manager.find_entity_by_path("Level/Spawner/Point03")->get_id(), point);
+    EXPECT_EQ(manager.find_entity_by_path("Spawner/Point03")->get_id(), decoy);
+    EXPECT_EQ(manager.find_entity_by_path("Level")->get_id(), level);
+
+    EXPECT_EQ(manager.find_entity_by_path("Spawner/Point03/Extra"), nullptr);
+    EXPECT_EQ(manager.find_entity_by_path("Level//Point03"), nullptr);
+    EXPECT_EQ(manager.find_entity_by_path(""), nullptr);
+
+    EXPECT_EQ(manager.get_path(point), "Level/Spawner/Point03");
+
+    manager.get_entity_by_id(spawner)->set_name("Emitter");
+    EXPECT_EQ(manager.find_entity_by_path("Level/Spawner/Point03"), nullptr);
+    EXPECT_EQ(manager.find_entity_by_path("Level/Emitter/Point03")->get_id(), point);
+}
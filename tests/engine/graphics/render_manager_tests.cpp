@@ -0,0 +1,49 @@
+// RenderManager is not part of the headless engine
+#ifndef TETRA_HEADLESS
+
+#include <gtest/gtest.h>
+
+#include "engine/graphics/render_manager.h"
+#include "engine/component/3d/camera_3d.h"
+#include "engine/component/3d/transform_3d.h"
+#include "engine/component/component_manager.h"
+#include "engine/entity/entity_manager.h"
+#include "engine/entity/entity.h"
+#include "engine/stage/stage_manager.h"
+
+using namespace Engine;
+using namespace Engine::Graphics;
+
+class RenderManagerTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+    FramePacket packet;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    Camera3D *spawn_camera(const std::string &name)
+    {
+        Entity *entity = stage->get_entity_manager().create_entity(name);
+        entity->add_component<Transform3D>();
+        return entity->add_component<Camera3D>();
+    }
+};
+
+TEST_F(RenderManagerTest, DisabledCameraIsNotExtracted)
+{
+    ComponentID enabled = spawn_camera("Enabled")->get_id();
+    spawn_camera("Disabled")->set_enabled(false);
+
+    RenderManager::get_instance().extract(packet);
+
+    ASSERT_EQ(packet.cameras.size(), 1u);
+    EXPECT_EQ(packet.cameras[0].camera, enabled);
+    EXPECT_EQ(packet.primary_camera, 0u);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "engine/jobs/job_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace Engine;
+
+TEST(JobSystemTest, WaitRunsEverySubmittedJob)
+{
+    JobSystem jobs(3);
+    JobCounter counter;
+    std::atomic<int> sum{0};
+
+    for (int i = 1; i <= 100; i++)
+        jobs.submit([&sum, i]()
+                    { sum += i; },
+                    &counter);
+
+    jobs.wait(counter);
+
+    EXPECT_TRUE(counter.is_done());
+    EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(JobSystemTest, WaitingThreadRunsJobsWithoutWorkers)
+{
+    JobSystem jobs(0);
+    JobCounter counter;
+    int runs = 0;
+
+    for (int i = 0; i < 10; i++)
+        jobs.submit([&runs]()
+                    { runs++; },
+                    &counter);
+
+    jobs.wait(counter);
+
+    EXPECT_EQ(jobs.get_worker_count(), 0u);
+    EXPECT_EQ(runs, 10);
+}
+
+TEST(JobSystemTest, NestedJobsCanWaitOnTheirChildren)
+{
+    JobSystem jobs(2);
+    JobCounter outer;
+    std::atomic<int> leaves{0};
+
+    for (int i = 0; i < 8; i++)
+    {
+        jobs.submit([&jobs, &leaves]()
+                    {
+                        JobCounter inner;
+                        for (int j = 0; j < 8; j++)
+                            jobs.submit([&leaves]() { leaves++; }, &inner);
+
+                        jobs.wait(inner); },
+                    &outer);
+    }
+
+    jobs.wait(outer);
+
+    EXPECT_EQ(leaves.load(), 64);
+}
+
+TEST(JobSystemTest, ParallelForCoversEveryIndexOnce)
+{
+    JobSystem jobs(4);
+    std::vector<int> hits(10000, 0);
+
+    jobs.parallel_for(hits.size(), 64, [&hits](size_t begin, size_t end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                              hits[i]++; });
+
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 10000);
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](int count)
+                            { return count == 1; }));
+}
+
+TEST(JobSystemTest, JobExceptionIsRethrownByWait)
+{
+    JobSystem jobs(2);
+    JobCounter counter;
+    std::atomic<int> runs{0};
+
+    jobs.submit([]()
+                { throw std::runtime_error("job failed"); },
+                &counter);
+    jobs.submit([&runs]()
+                { runs++; },
+                &counter);
+
+    EXPECT_THROW(jobs.wait(counter), std::runtime_error);
+    EXPECT_TRUE(counter.is_done());
+    EXPECT_EQ(runs.load(), 1);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "engine/math/matrix4_batch.h"
+
+#include <vector>
+
+using namespace Engine::Math;
+
+namespace
+{
+    struct TRSArrays
+    {
+        std::vector<float> px, py, pz, qx, qy, qz, qw, sx, sy, sz;
+
+        explicit TRSArrays(size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                float f = static_cast<float>(i);
+
+                Quaternion q = Quaternion::from_euler(0.1f * f, -0.2f * f, 0.3f * f).normalized();
+
+                px.push_back(f);
+                py.push_back(-2.0f * f);
+                pz.push_back(0.5f);
+                qx.push_back(q.x);
+                qy.push_back(q.y);
+                qz.push_back(q.z);
+                qw.push_back(q.w);
+                sx.push_back(1.0f + f);
+                sy.push_back(2.0f);
+                sz.push_back(0.25f * (f + 1.0f));
+            }
+        }
+
+        TRSBatch batch() const
+        {
+            return {px.data(), py.data(), pz.data(), qx.data(), qy.data(), qz.data(), qw.data(),
+                    sx.data(), sy.data(), sz.data()};
+        }
+
+        Matrix4 expected(size_t i) const
+        {
+            return Matrix4::translate(Vector3(px[i], py[i], pz[i])) *
+                   Matrix4::rotate(Quaternion(qx[i], qy[i], qz[i], qw[i])) *
+                   Matrix4::scale(Vector3(sx[i], sy[i], sz[i]));
+        }
+    };
+}
+
+TEST(Matrix4BatchTest, ScalarMatchesMatrixProduct)
+{
+    TRSArrays arrays(5);
+    std::vector<Matrix4> out(5);
+
+    compose_trs_scalar(arrays.batch(), out.size(), out.data());
+
+    for (size_t i = 0; i < out.size(); i++)
+        EXPECT_TRUE(out[i].equals_eps(arrays.expected(i), 1e-4f)) << "index " << i;
+}
+
+TEST(Matrix4BatchTest, SimdMatchesScalarIncludingRemainder)
+{
+    // 19 covers full 8 and 4 wide iterations plus a scalar tail
+    TRSArrays arrays(19);
+    std::vector<Matrix4> simd(19), scalar(19);
+
+    compose_trs(arrays.batch(), simd.size(), simd.data());
+    compose_trs_scalar(arrays.batch(), scalar.size(), scalar.data());
+
+    for (size_t i = 0; i < simd.size(); i++)
+        EXPECT_TRUE(simd[i].equals_eps(scalar[i], 1e-5f)) << "index " << i;
+}
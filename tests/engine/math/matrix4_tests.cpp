@@ -107,6 +107,20 @@ TEST(Matrix4, LookAtMatchesGLM)
     Matrix4 M = Matrix4::look_at(eye, center, up);
     glm::mat4 G = glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
 
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            EXPECT_NEAR(M[c][r], G[c][r], EPSILON);
+}
+
+TEST(Matrix4, LookAtOffAxisMatchesGLM)
+{
+    Vector3 eye(3, 2, -4);
+    Vector3 center(-1, 0.5f, 2);
+    Vector3 up(0, 1, 0);
+
+    Matrix4 M = Matrix4::look_at(eye, center, up);
+    glm::mat4 G = glm::lookAt(glm::vec3(3, 2, -4), glm::vec3(-1, 0.5f, 2), glm::vec3(0, 1, 0));
+
     for (int c = 0; c < 4; ++c)
         for (int r = 0; r < 4; ++r)
             EXPECT_NEAR(M[c][r], G[c][r], EPSILON);
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "engine/runtime/frame_pacer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Engine;
+
+using clock_type = std::chrono::steady_clock;
+
+TEST(FramePacerTest, WaitHoldsTheTargetRate)
+{
+    FramePacer pacer(200.0);
+
+    auto start = clock_type::now();
+    for (int i = 0; i < 20; i++)
+        pacer.wait();
+
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+
+    // 20 frames at 5 ms each, only ever late
+    EXPECT_GE(elapsed.count(), 0.099);
+    EXPECT_EQ(pacer.get_stats().frames, 20u);
+    EXPECT_GE(pacer.get_stats().max_overshoot_milliseconds, 0.0);
+    EXPECT_GE(pacer.get_stats().max_overshoot_milliseconds, pacer.get_stats().average_overshoot_milliseconds);
+}
+
+TEST(FramePacerTest, DisabledPacingReturnsImmediately)
+{
+    FramePacer pacer(0.0);
+    EXPECT_EQ(pacer.get_target_rate(), 0.0);
+
+    auto start = clock_type::now();
+    for (int i = 0; i < 1000; i++)
+        pacer.wait();
+
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+
+    EXPECT_LT(elapsed.count(), 0.05);
+    EXPECT_EQ(pacer.get_stats().frames, 0u);
+}
+
+TEST(FramePacerTest, MissedDeadlinesAreNotCaughtUp)
+{
+    FramePacer pacer(100.0);
+    pacer.wait();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto start = clock_type::now();
+    pacer.wait();
+    pacer.wait();
+
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+
+    // The late frame runs now, the one after waits a full period instead of running back to back
+    EXPECT_EQ(pacer.get_stats().missed_deadlines, 1u);
+    EXPECT_GE(elapsed.count(), 0.0099);
+}
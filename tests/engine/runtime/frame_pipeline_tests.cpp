@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "engine/runtime/frame_pipeline.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Fills a packet so the render side can tell whether it saw a half written one
+    void fill_packet(Graphics::FramePacket &packet, uint64_t frame)
+    {
+        packet.clear();
+        packet.frame = frame;
+
+        for (uint32_t i = 0; i < frame % 7 + 1; i++)
+            packet.objects.push_back({EntityID{static_cast<uint32_t>(frame), 0}, Math::Matrix4()});
+    }
+}
+
+TEST(FramePipelineTest, RendersEveryPacketInOrder)
+{
+    FramePipeline pipeline;
+
+    std::vector<uint64_t> rendered;
+    bool consistent = true;
+
+    pipeline.start([&](const Graphics::FramePacket &packet)
+                   {
+                       rendered.push_back(packet.frame);
+
+                       consistent &= packet.objects.size() == packet.frame % 7 + 1;
+                       for (const Graphics::ObjectPacket &object : packet.objects)
+                           consistent &= object.entity.index == packet.frame; });
+
+    for (uint64_t frame = 1; frame <= 200; frame++)
+    {
+        fill_packet(pipeline.begin_extract(), frame);
+        pipeline.submit();
+    }
+
+    pipeline.stop();
+
+    ASSERT_EQ(rendered.size(), 200u);
+    for (uint64_t frame = 1; frame <= 200; frame++)
+        EXPECT_EQ(rendered[frame - 1], frame);
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(pipeline.get_stats().rendered_frames, 200u);
+}
+
+TEST(FramePipelineTest, RenderingOverlapsTheNextFrame)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr auto frame_cost = std::chrono::milliseconds(20);
+
+    FramePipeline pipeline;
+    pipeline.start([&](const Graphics::FramePacket &)
+                   { std::this_thread::sleep_for(frame_cost); });
+
+    auto start = clock::now();
+
+    for (uint64_t frame = 1; frame <= 10; frame++)
+    {
+        std::this_thread::sleep_for(frame_cost); // Simulation
+
+        fill_packet(pipeline.begin_extract(), frame);
+        pipeline.submit();
+    }
+
+    pipeline.wait_idle();
+    std::chrono::duration<double> elapsed = clock::now() - start;
+
+    pipeline.stop();
+
+    // Back to back would take 400 ms, pipelined about 220 ms
+    EXPECT_LT(elapsed.count(), 0.34);
+}
+
+TEST(FramePipelineTest, RenderErrorsReachTheSimulationThread)
+{
+    FramePipeline pipeline;
+    pipeline.start([](const Graphics::FramePacket &packet)
+                   {
+                       if (packet.frame == 2)
+                           throw std::runtime_error("Lost the GL context"); });
+
+    // Surfaces from whichever call comes first after frame 2 rendered, at the latest when frame 4
+    // waits for frame 2's packet, and keeps surfacing
+    uint64_t failed_frame = 0;
+    for (uint64_t frame = 1; frame <= 10 && failed_frame == 0; frame++)
+    {
+        try
+        {
+            fill_packet(pipeline.begin_extract(), frame);
+            pipeline.submit();
+        }
+        catch (const std::runtime_error &)
+        {
+            failed_frame = frame;
+        }
+    }
+
+    EXPECT_GE(failed_frame, 2u);
+    EXPECT_LE(failed_frame, 4u);
+    EXPECT_THROW(pipeline.begin_extract(), std::runtime_error);
+    EXPECT_THROW(pipeline.stop(), std::runtime_error);
+    EXPECT_FALSE(pipeline.is_running());
+
+    // A stopped pipeline can be started again
+    pipeline.start([](const Graphics::FramePacket &) {});
+    fill_packet(pipeline.begin_extract(), 3);
+    pipeline.submit();
+    EXPECT_NO_THROW(pipeline.stop());
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/entity/entity.h"
+#include "engine/jobs/job_system.h"
+#include "engine/stage/stage_manager.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    class Mass : public Component
+    {
+    public:
+        float value = 1.0f;
+    };
+
+    class Label : public Component
+    {
+    public:
+        int value = 0;
+    };
+}
+
+REGISTER_COMPONENT(CommandMass, Mass)
+REGISTER_COMPONENT(CommandLabel, Label)
+
+class CommandBufferTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    Entity *spawn(const std::string &name)
+    {
+        return stage->get_entity_manager().create_entity(name);
+    }
+};
+
+TEST_F(CommandBufferTest, CommandsApplyOnlyAtPlayback)
+{
+    EntityID existing = spawn("Existing")->get_id();
+
+    CommandBuffer &commands = stage->get_command_buffer();
+
+    auto created = commands.create_entity("Created");
+    commands.add_component(created, Mass());
+    commands.add_component<Label>(existing);
+
+    EXPECT_EQ(stage->get_entity_manager().get_entity_count(), 1u);
+    EXPECT_FALSE(stage->get_entity_manager().get_entity_by_id(existing)->has_component<Label>());
+
+    stage->playback_commands();
+
+    EXPECT_TRUE(commands.empty());
+    EXPECT_EQ(stage->get_entity_manager().get_entity_count(), 2u);
+    EXPECT_TRUE(stage->get_entity_manager().get_entity_by_id(existing)->has_component<Label>());
+    EXPECT_EQ(stage->view<Mass>().size(), 1u);
+}
+
+TEST_F(CommandBufferTest, AddedComponentKeepsRecordedValue)
+{
+    EntityID id = spawn("A")->get_id();
+
+    Label label;
+    label.value = 7;
+    stage->get_command_buffer().add_component(id, std::move(label));
+    stage->playback_commands();
+
+    Label *stored = stage->get_entity_manager().get_entity_by_id(id)->get_component<Label>();
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->value, 7);
+    EXPECT_EQ(stored->get_owner_id(), id);
+}
+
+TEST_F(CommandBufferTest, EntityCreatedAndDestroyedInBatchIsNeverCreated)
+{
+    size_t created_events = 0;
+    stage->get_component_manager().component_created.subscribe([&](ComponentHandle<Component>)
+                                                               { created_events++; });
+
+    CommandBuffer &commands = stage->get_command_buffer();
+    auto temporary = commands.create_entity("Temporary");
+    commands.add_component<Mass>(temporary);
+    commands.destroy_entity(temporary);
+
+    stage->playback_commands();
+
+    EXPECT_EQ(stage->get_entity_manager().get_entity_count(), 0u);
+    EXPECT_EQ(created_events, 0u);
+}
+
+TEST_F(CommandBufferTest, ChangesToDestroyedEntityAreDropped)
+{
+    EntityID id = spawn("Doomed")->get_id();
+
+    CommandBuffer &commands = stage->get_command_buffer();
+    commands.add_component<Mass>(id);
+    commands.destroy_entity(id);
+
+    stage->playback_commands();
+
+    EXPECT_FALSE(stage->get_entity_manager().has_entity(id));
+    EXPECT_EQ(stage->get_component_manager().get_component_count<Mass>(), 0u);
+}
+
+TEST_F(CommandBufferTest, ComponentChangesCoalesceIntoOneMove)
+{
+    Entity *entity = spawn("A");
+    EntityID id = entity->get_id();
+    entity->add_component<Mass>();
+
+    size_t archetypes_before = stage->get_component_manager().get_archetypes().size();
+
+    CommandBuffer &commands = stage->get_command_buffer();
+    commands.remove_component<Mass>(id);
+    commands.add_component<Label>(id);
+
+    stage->playback_commands();
+
+    // Only the Label archetype is created, the entity never passes through an empty one
+    EXPECT_EQ(stage->get_component_manager().get_archetypes().size(), archetypes_before + 1);
+    EXPECT_FALSE(stage->get_component_manager().has_component<Mass>(id));
+    EXPECT_TRUE(stage->get_component_manager().has_component<Label>(id));
+}
+
+TEST_F(CommandBufferTest, WorkersRecordIntoTheirOwnBuffers)
+{
+    JobSystem jobs(3);
+
+    jobs.parallel_for(64, 4, [this](size_t begin, size_t end)
+                      {
+                          CommandBuffer &commands = stage->get_command_buffer();
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              auto entity = commands.create_entity("Spawned" + std::to_string(i));
+                              commands.add_component<Mass>(entity);
+                          } });
+
+    stage->playback_commands();
+
+    EXPECT_EQ(stage->get_entity_manager().get_entity_count(), 64u);
+    EXPECT_EQ(stage->view<Mass>().size(), 64u);
+}
+
+TEST(CommandBufferPoolTest, ThreadKeepsOneBufferPerPool)
+{
+    std::vector<std::unique_ptr<CommandBufferPool>> pools;
+    for (int i = 0; i < 12; i++)
+        pools.push_back(std::make_unique<CommandBufferPool>());
+
+    std::vector<CommandBuffer *> buffers;
+    for (auto &pool : pools)
+        buffers.push_back(&pool->get_local());
+
+    // Alternating between more pools than the thread caches still finds each pool's own buffer
+    for (int round = 0; round < 3; round++)
+    {
+        for (size_t i = 0; i < pools.size(); i++)
+            EXPECT_EQ(&pools[i]->get_local(), buffers[i]);
+    }
+
+    pools[0]->get_local().create_entity("Pending");
+    EXPECT_FALSE(pools[0]->empty());
+    EXPECT_TRUE(pools[1]->empty());
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/component/reference_remap.h"
+#include "engine/entity/entity.h"
+#include "engine/stage/prefab.h"
+#include "engine/stage/stage_manager.h"
+
+#include <string>
+
+using namespace Engine;
+
+namespace
+{
+    class Armor : public Component
+    {
+    public:
+        int value = 0;
+    };
+
+    class Tether : public Component
+    {
+    public:
+        EntityID target = EntityID::Invalid;
+        ComponentHandle<Armor> armor;
+
+        void remap_references(const ReferenceRemap &remap) override
+        {
+            target = remap.map(target);
+            armor = remap.map(armor);
+        }
+    };
+}
+
+REGISTER_COMPONENT(PrefabArmor, Armor)
+REGISTER_COMPONENT(PrefabTether, Tether)
+
+class PrefabTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    EntityManager &entities() { return stage->get_entity_manager(); }
+    ComponentManager &components() { return stage->get_component_manager(); }
+};
+
+TEST_F(PrefabTest, InstancesCopyHierarchyAndComponentData)
+{
+    EntityID root = entities().create_entity("Enemy")->get_id();
+    EntityID weapon = entities().create_entity("Weapon")->get_id();
+    EntityID shield = entities().create_entity("Shield")->get_id();
+    entities().set_parent(weapon, root);
+    entities().set_parent(shield, root);
+
+    entities().get_entity_by_id(root)->add_component<Armor>()->value = 7;
+    entities().get_entity_by_id(shield)->add_component<Armor>()->value = 3;
+
+    Prefab prefab = Prefab::bake(*stage, root);
+    EXPECT_EQ(prefab.get_entity_count(), 3u);
+    EXPECT_EQ(prefab.get_component_count(), 2u);
+
+    std::vector<EntityID> roots;
+    entities().instantiate(prefab, 4, roots);
+
+    ASSERT_EQ(roots.size(), 4u);
+    EXPECT_EQ(entities().get_entity_count(), 15u);
+    EXPECT_EQ(components().get_component_count<Armor>(), 10u);
+
+    for (EntityID instance : roots)
+    {
+        EXPECT_NE(instance, root);
+
+        Entity *instance_root = entities().get_entity_by_id(instance);
+        EXPECT_EQ(instance_root->get_name(), "Enemy");
+        EXPECT_EQ(instance_root->get_parent(), nullptr);
+        EXPECT_EQ(components().read_component<Armor>(instance)->value, 7);
+        EXPECT_EQ(components().read_component<Armor>(instance)->get_owner_id(), instance);
+
+        std::string path = entities().get_path(instance_root->get_children()[1]->get_id());
+        EXPECT_EQ(path, "Enemy/Shield");
+
+        EntityID instance_shield = instance_root->get_children()[1]->get_id();
+        EXPECT_EQ(components().read_component<Armor>(instance_shield)->value, 3);
+    }
+
+    // Editing an instance leaves the prefab and the source alone
+    components().get_component<Armor>(roots[0])->value = 99;
+    EXPECT_EQ(components().read_component<Armor>(root)->value, 7);
+
+    std::vector<EntityID> more;
+    entities().instantiate(prefab, 1, more);
+    EXPECT_EQ(components().read_component<Armor>(more[0])->value, 7);
+}
+
+TEST_F(PrefabTest, InternalReferencesPointIntoTheirInstance)
+{
+    EntityID outside = entities().create_entity("Outside")->get_id();
+    EntityID root = entities().create_entity("Turret")->get_id();
+    EntityID barrel = entities().create_entity("Barrel")->get_id();
+    entities().set_parent(barrel, root);
+
+    entities().get_entity_by_id(barrel)->add_component<Armor>();
+
+    Tether *to_barrel = entities().get_entity_by_id(root)->add_component<Tether>();
+    to_barrel->target = barrel;
+    to_barrel->armor = components().get_handle<Armor>(barrel);
+
+    entities().get_entity_by_id(barrel)->add_component<Tether>()->target = outside;
+
+    Prefab prefab = Prefab::bake(*stage, root);
+
+    std::vector<EntityID> roots;
+    entities().instantiate(prefab, 2, roots);
+
+    for (EntityID instance : roots)
+    {
+        EntityID instance_barrel = entities().get_entity_by_id(instance)->get_children()[0]->get_id();
+
+        const Tether *tether = components().read_component<Tether>(instance);
+        EXPECT_EQ(tether->target, instance_barrel);
+        EXPECT_EQ(components().resolve(tether->armor), components().get_component<Armor>(instance_barrel));
+
+        // References leaving the prefab are kept
+        EXPECT_EQ(components().read_component<Tether>(instance_barrel)->target, outside);
+    }
+}
+
+TEST_F(PrefabTest, DisabledEntitiesStayInactiveInInstances)
+{
+    EntityID root = entities().create_entity("Spawner")->get_id();
+    EntityID hidden = entities().create_entity("Hidden")->get_id();
+    EntityID below = entities().create_entity("Below")->get_id();
+    entities().set_parent(hidden, root);
+    entities().set_parent(below, hidden);
+
+    entities().get_entity_by_id(below)->add_component<Armor>();
+    entities().set_enabled(hidden, false);
+
+    Prefab prefab = Prefab::bake(*stage, root);
+
+    std::vector<EntityID> roots;
+    entities().instantiate(prefab, 3, roots);
+
+    EXPECT_EQ(entities().get_active_count(), 4u);
+    EXPECT_EQ(stage->view<const Armor>().size(), 0u);
+    EXPECT_EQ(stage->view<const Armor>().include_inactive().size(), 4u);
+
+    Entity *instance_hidden = entities().get_entity_by_id(roots[0])->get_children()[0];
+    EXPECT_FALSE(instance_hidden->is_enabled());
+
+    entities().set_enabled(instance_hidden->get_id(), true);
+    EXPECT_EQ(stage->view<const Armor>().size(), 1u);
+}
+
+TEST_F(PrefabTest, BakingMissingEntityThrows)
+{
+    EntityID gone = entities().create_entity("Gone")->get_id();
+    entities().destroy_entity(gone);
+
+    EXPECT_THROW(Prefab::bake(*stage, gone), std::runtime_error);
+}
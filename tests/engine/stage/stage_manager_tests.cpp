@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/entity/entity.h"
+#include "engine/serialization/json/json_serialization_context.h"
+#include "engine/stage/stage_manager.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    class Ticker : public Component
+    {
+    public:
+        int updates = 0;
+
+        void update(float) override { updates++; }
+    };
+
+    class Faulty : public Component
+    {
+    public:
+        void update(float) override { throw std::runtime_error("Faulty update"); }
+    };
+
+    // Counts across threads so the test can read it while its stage runs
+    class Heartbeat : public Component
+    {
+    public:
+        static inline std::atomic<int> beats{0};
+
+        void update(float) override { beats++; }
+    };
+}
+
+REGISTER_COMPONENT(StageManagerTicker, Ticker)
+REGISTER_COMPONENT(StageManagerFaulty, Faulty)
+REGISTER_COMPONENT(StageManagerHeartbeat, Heartbeat)
+
+TEST(StageTest, TickRunsWholeFixedStepsAndKeepsTheRemainder)
+{
+    Stage stage(true);
+    stage.set_fixed_timestep(0.1);
+
+    EXPECT_EQ(stage.tick(0.25), 2u);
+    EXPECT_EQ(stage.tick(0.04), 0u);
+    EXPECT_EQ(stage.tick(0.02), 1u);
+}
+
+TEST(StageTest, TickDropsStepsItCannotCatchUp)
+{
+    Stage stage(true);
+    stage.set_fixed_timestep(0.01);
+
+    EXPECT_EQ(stage.tick(1.0), Stage::MAX_FIXED_STEPS_PER_TICK);
+    EXPECT_EQ(stage.tick(0.0), 0u);
+}
+
+TEST(StageManagerTest, AddComponentUsesTheEntitysOwnStage)
+{
+    StageManager &stage_manager = StageManager::get_instance();
+    stage_manager.load_new_stage();
+
+    Stage *stage = stage_manager.create_stage();
+    EXPECT_EQ(stage_manager.get_stage(stage->get_guid()), stage);
+
+    Entity *entity = stage->get_entity_manager().create_entity("Remote");
+    entity->add_component<Ticker>();
+
+    EXPECT_TRUE(stage->get_component_manager().has_component<Ticker>(entity->get_id()));
+    EXPECT_EQ(stage_manager.get_current_stage()->get_component_manager().get_component_count<Ticker>(), 0u);
+
+    GUID guid = stage->get_guid();
+    stage_manager.destroy_stage(guid);
+    EXPECT_EQ(stage_manager.get_stage(guid), nullptr);
+}
+
+TEST(StageManagerTest, RegisteredStagesRunInParallel)
+{
+    StageManager &stage_manager = StageManager::get_instance();
+
+    std::vector<Stage *> stages;
+    std::vector<EntityID> tickers;
+
+    for (int i = 0; i < 3; i++)
+    {
+        Stage *stage = stage_manager.create_stage();
+        stage->set_fixed_timestep(0.001);
+
+        std::vector<EntityID> created;
+        stage->get_entity_manager().create_entities<Ticker>(8, created, "Ticker");
+
+        stages.push_back(stage);
+        tickers.push_back(created[0]);
+    }
+
+    stage_manager.start_stages();
+    EXPECT_TRUE(stage_manager.is_running());
+    EXPECT_THROW(stage_manager.destroy_stage(stages[0]->get_guid()), std::runtime_error);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    stage_manager.stop_stages();
+    EXPECT_FALSE(stage_manager.is_running());
+
+    for (size_t i = 0; i < stages.size(); i++)
+    {
+        EXPECT_GT(stages[i]->get_component_manager().read_component<Ticker>(tickers[i])->updates, 0);
+        stage_manager.destroy_stage(stages[i]->get_guid());
+    }
+
+    EXPECT_EQ(stage_manager.get_stage_count(), 0u);
+}
+
+TEST(StageManagerTest, StageThreadEndsWhenItsStageRequestsShutdown)
+{
+    StageManager &stage_manager = StageManager::get_instance();
+
+    Stage *stage = stage_manager.create_stage();
+    stage->request_shutdown();
+
+    stage_manager.start_stages();
+    stage_manager.stop_stages();
+
+    EXPECT_FALSE(stage_manager.is_running());
+    stage_manager.destroy_stage(stage->get_guid());
+}
+
+TEST(StageManagerTest, ThrowingStageShutsDownAlone)
+{
+    StageManager &stage_manager = StageManager::get_instance();
+
+    Stage *faulty = stage_manager.create_stage();
+    faulty->set_fixed_timestep(0.001);
+    faulty->get_entity_manager().create_entity("Faulty")->add_component<Faulty>();
+
+    Stage *healthy = stage_manager.create_stage();
+    healthy->set_fixed_timestep(0.001);
+    healthy->get_entity_manager().create_entity("Heartbeat")->add_component<Heartbeat>();
+
+    stage_manager.start_stages();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_TRUE(faulty->has_requested_shutdown());
+    EXPECT_FALSE(healthy->has_requested_shutdown());
+    int beats = Heartbeat::beats.load();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stage_manager.stop_stages();
+
+    // The healthy stage kept ticking after the faulty one stopped
+    EXPECT_GT(Heartbeat::beats.load(), beats);
+
+    stage_manager.destroy_stage(faulty->get_guid());
+    stage_manager.destroy_stage(healthy->get_guid());
+}
+
+TEST(StageManagerTest, CreateStageLoadsAStageFile)
+{
+    StageManager &stage_manager = StageManager::get_instance();
+
+    Stage source(true);
+    source.get_entity_manager().create_entity("Match");
+
+    Serialization::JSONSerializationContext ctx(&source);
+    source.serialize(ctx);
+
+    const std::string path = "stage_manager_test.stage";
+    std::ofstream(path) << ctx.get_root().to_text();
+
+    Stage *stage = stage_manager.create_stage(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(stage_manager.get_stage(stage->get_guid()), stage);
+    EXPECT_NE(stage->get_entity_manager().find_entity("Match"), nullptr);
+
+    stage_manager.destroy_stage(stage->get_guid());
+}
+
+TEST(StageManagerTest, CreateStageThrowsForAMissingFile)
+{
+    EXPECT_THROW(StageManager::get_instance().create_stage("missing.stage"), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/entity/entity.h"
+#include "engine/stage/stage_manager.h"
+#include "engine/stage/stage_snapshot_ring.h"
+
+using namespace Engine;
+
+namespace
+{
+    class Position : public Component
+    {
+    public:
+        float x = 0.0f;
+    };
+
+    class Stamina : public Component
+    {
+    public:
+        int value = 10;
+    };
+}
+
+REGISTER_COMPONENT(SnapshotPosition, Position)
+REGISTER_COMPONENT(SnapshotStamina, Stamina)
+
+class StageSnapshotRingTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+
+    EntityManager &entities() { return stage->get_entity_manager(); }
+    ComponentManager &components() { return stage->get_component_manager(); }
+};
+
+TEST_F(StageSnapshotRingTest, RestoreRewindsDataAndStructure)
+{
+    StageSnapshotRing ring(4);
+
+    std::vector<EntityID> runners;
+    entities().create_entities<Position>(3, runners, "Runner");
+    components().get_component<Position>(runners[0])->x = 1.0f;
+
+    ring.capture(*stage, 0);
+    EXPECT_GT(ring.get_stats().capture_bytes, 0u);
+
+    // Change values, destroy an entity, create one and move another into a new archetype
+    components().get_component<Position>(runners[0])->x = 5.0f;
+    entities().destroy_entity(runners[1]);
+    EntityID late = entities().create_entity("Late")->get_id();
+    entities().get_entity_by_id(runners[2])->add_component<Stamina>()->value = 3;
+    entities().set_enabled(runners[0], false);
+
+    ASSERT_TRUE(ring.restore(*stage, 0));
+
+    EXPECT_EQ(entities().get_entity_count(), 3u);
+    EXPECT_EQ(entities().get_active_count(), 3u);
+    EXPECT_TRUE(entities().has_entity(runners[1]));
+    EXPECT_FALSE(entities().has_entity(late));
+    EXPECT_EQ(entities().find_entities("Runner").size(), 3u);
+
+    EXPECT_FLOAT_EQ(components().read_component<Position>(runners[0])->x, 1.0f);
+    EXPECT_FALSE(components().has_component<Stamina>(runners[2]));
+    EXPECT_EQ(stage->view<const Position>().size(), 3u);
+    EXPECT_EQ(stage->view<const Stamina>().size(), 0u);
+
+    // Replaying the same changes hands out the same IDs again
+    entities().destroy_entity(runners[1]);
+    EntityID again = entities().create_entity("Late")->get_id();
+    EXPECT_EQ(again, late);
+    entities().get_entity_by_id(again)->add_component<Stamina>();
+    EXPECT_EQ(stage->view<const Stamina>().size(), 1u);
+}
+
+TEST_F(StageSnapshotRingTest, OldFramesAreOverwritten)
+{
+    StageSnapshotRing ring(2);
+
+    EntityID id = entities().create_entity("Counter")->get_id();
+    entities().get_entity_by_id(id)->add_component<Stamina>();
+
+    for (uint64_t frame = 0; frame < 3; frame++)
+    {
+        components().get_component<Stamina>(id)->value = static_cast<int>(frame);
+        ring.capture(*stage, frame);
+    }
+
+    EXPECT_FALSE(ring.contains(0));
+    EXPECT_FALSE(ring.restore(*stage, 0));
+    EXPECT_EQ(ring.get_latest_frame(), 2u);
+
+    ASSERT_TRUE(ring.restore(*stage, 1));
+    EXPECT_EQ(components().read_component<Stamina>(id)->value, 1);
+
+    ASSERT_TRUE(ring.restore(*stage, 2));
+    EXPECT_EQ(components().read_component<Stamina>(id)->value, 2);
+}
+
+TEST_F(StageSnapshotRingTest, RestoredComponentsKeepIdentityAndSubscribers)
+{
+    StageSnapshotRing ring(2);
+
+    std::vector<EntityID> runners;
+    entities().create_entities<Position>(3, runners, "Runner");
+
+    std::vector<size_t> instance_ids;
+    for (EntityID id : runners)
+        instance_ids.push_back(components().read_component<Position>(id)->get_instance_id());
+
+    int hits = 0;
+    components().get_component<Position>(runners[0])->subscribe("Hit", std::function<void(int)>([&](int damage)
+                                                                                               { hits += damage; }));
+
+    ring.capture(*stage, 0);
+
+    // Disabling the first runner swaps its row with the last one
+    entities().set_enabled(runners[0], false);
+    ASSERT_TRUE(ring.restore(*stage, 0));
+
+    for (size_t i = 0; i < runners.size(); i++)
+        EXPECT_EQ(components().read_component<Position>(runners[i])->get_instance_id(), instance_ids[i]);
+
+    components().get_component<Position>(runners[2])->invoke("Hit", 5);
+    EXPECT_EQ(hits, 0);
+
+    components().get_component<Position>(runners[0])->invoke("Hit", 3);
+    EXPECT_EQ(hits, 3);
+}
@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include "engine/component/component_manager.h"
+#include "engine/component/component_registry.h"
+#include "engine/entity/entity.h"
+#include "engine/jobs/job_system.h"
+#include "engine/stage/stage_manager.h"
+#include "engine/system/system_scheduler.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace Engine;
+
+namespace
+{
+    class Position : public Component
+    {
+    public:
+        float x = 0.0f;
+    };
+
+    class Speed : public Component
+    {
+    public:
+        float x = 1.0f;
+    };
+
+    class Tint : public Component
+    {
+    public:
+        int value = 0;
+    };
+}
+
+REGISTER_COMPONENT(SchedulerPosition, Position)
+REGISTER_COMPONENT(SchedulerSpeed, Speed)
+REGISTER_COMPONENT(SchedulerTint, Tint)
+
+namespace
+{
+    class MoveSystem : public System
+    {
+    public:
+        MoveSystem() : System("Move")
+        {
+            reads<Speed>();
+            writes<Position>();
+        }
+
+        void update(Stage &stage, float delta_time) override
+        {
+            stage.view<Position, const Speed>().each([delta_time](EntityID, Position &position, const Speed &speed)
+                                                     { position.x += speed.x * delta_time; });
+        }
+    };
+
+    class ReadPositionSystem : public System
+    {
+    public:
+        float sum = 0.0f;
+
+        ReadPositionSystem() : System("ReadPosition") { reads<Position>(); }
+
+        void update(Stage &stage, float) override
+        {
+            sum = 0.0f;
+            stage.view<const Position>().each([this](EntityID, const Position &position)
+                                              { sum += position.x; });
+        }
+    };
+
+    class TintSystem : public System
+    {
+    public:
+        TintSystem() : System("Tint") { writes<Tint>(); }
+
+        void update(Stage &stage, float) override
+        {
+            stage.view<Tint>().each([](EntityID, Tint &tint)
+                                    { tint.value++; });
+        }
+    };
+
+    class CountingSystem : public System
+    {
+    public:
+        std::atomic<int> runs{0};
+
+        explicit CountingSystem(bool exclusive) : System("Counting")
+        {
+            reads<Speed>();
+            if (exclusive)
+                set_exclusive();
+        }
+
+        void update(Stage &, float) override { runs++; }
+    };
+
+    // Counts the positions written since its previous run
+    class ChangedPositionSystem : public System
+    {
+    public:
+        size_t changed = 0;
+
+        ChangedPositionSystem() : System("ChangedPosition") { reads<Position>(); }
+
+        void update(Stage &stage, float) override
+        {
+            changed = stage.view<const Position>().changed_since<Position>(get_last_run_tick()).size();
+        }
+    };
+
+    class ThrowingSystem : public System
+    {
+    public:
+        ThrowingSystem() : System("Throwing") { reads<Speed>(); }
+
+        void update(Stage &, float) override { throw std::runtime_error("system failed"); }
+    };
+}
+
+class SystemSchedulerTest : public ::testing::Test
+{
+protected:
+    Stage *stage = nullptr;
+
+    void SetUp() override
+    {
+        StageManager::get_instance().load_new_stage();
+        stage = StageManager::get_instance().get_current_stage();
+    }
+};
+
+TEST_F(SystemSchedulerTest, ConflictingSystemsKeepRegistrationOrder)
+{
+    SystemScheduler scheduler;
+    scheduler.add_system<MoveSystem>();
+    scheduler.add_system<TintSystem>();
+    scheduler.add_system<ReadPositionSystem>();
+
+    const auto &layers = scheduler.get_layers();
+
+    ASSERT_EQ(layers.size(), 2u);
+    ASSERT_EQ(layers[0].size(), 2u);
+    EXPECT_EQ(layers[0][0]->get_name(), "Move");
+    EXPECT_EQ(layers[0][1]->get_name(), "Tint");
+    ASSERT_EQ(layers[1].size(), 1u);
+    EXPECT_EQ(layers[1][0]->get_name(), "ReadPosition");
+}
+
+TEST_F(SystemSchedulerTest, ReadersShareALayer)
+{
+    SystemScheduler scheduler;
+    scheduler.add_system<ReadPositionSystem>();
+    scheduler.add_system<ReadPositionSystem>();
+    scheduler.add_system<CountingSystem>(false);
+
+    EXPECT_EQ(scheduler.get_layers().size(), 1u);
+}
+
+TEST_F(SystemSchedulerTest, ExclusiveSystemRunsAlone)
+{
+    SystemScheduler scheduler;
+    scheduler.add_system<CountingSystem>(false);
+    scheduler.add_system<CountingSystem>(true);
+    scheduler.add_system<CountingSystem>(false);
+
+    const auto &layers = scheduler.get_layers();
+
+    ASSERT_EQ(layers.size(), 3u);
+    EXPECT_EQ(layers[1].size(), 1u);
+}
+
+TEST_F(SystemSchedulerTest, RunAppliesSystemsInDependencyOrder)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        Entity *entity = stage->get_entity_manager().create_entity("E" + std::to_string(i));
+        entity->add_component<Position>();
+        entity->add_component<Speed>()->x = 2.0f;
+        entity->add_component<Tint>();
+    }
+
+    SystemScheduler &scheduler = stage->get_system_scheduler();
+    scheduler.add_system<MoveSystem>();
+    scheduler.add_system<TintSystem>();
+    ReadPositionSystem *reader = scheduler.add_system<ReadPositionSystem>();
+
+    stage->update(0.5f);
+
+    EXPECT_FLOAT_EQ(reader->sum, 4.0f);
+    stage->view<Tint>().each([](EntityID, Tint &tint)
+                             { EXPECT_EQ(tint.value, 1); });
+}
+
+TEST_F(SystemSchedulerTest, LayersRunOnTheStageJobSystem)
+{
+    JobSystem jobs(2);
+    stage->set_job_system(&jobs);
+
+    for (int i = 0; i < 16; i++)
+    {
+        Entity *entity = stage->get_entity_manager().create_entity("E" + std::to_string(i));
+        entity->add_component<Position>();
+        entity->add_component<Tint>();
+    }
+
+    SystemScheduler &scheduler = stage->get_system_scheduler();
+    scheduler.add_system<MoveSystem>();
+    scheduler.add_system<TintSystem>();
+    CountingSystem *counter = scheduler.add_system<CountingSystem>(false);
+
+    for (int frame = 0; frame < 10; frame++)
+        stage->update(0.1f);
+
+    stage->set_job_system(nullptr);
+
+    EXPECT_EQ(counter->runs.load(), 10);
+    stage->view<Tint>().each([](EntityID, Tint &tint)
+                             { EXPECT_EQ(tint.value, 10); });
+}
+
+TEST_F(SystemSchedulerTest, SystemExceptionIsRethrownAfterLayer)
+{
+    JobSystem jobs(1);
+    stage->set_job_system(&jobs);
+
+    SystemScheduler scheduler;
+    CountingSystem *counter = scheduler.add_system<CountingSystem>(false);
+    scheduler.add_system<ThrowingSystem>();
+
+    EXPECT_THROW(scheduler.run(*stage, 0.0f), std::runtime_error);
+    EXPECT_EQ(counter->runs.load(), 1);
+
+    stage->set_job_system(nullptr);
+}
+
+TEST_F(SystemSchedulerTest, ChangeTicksReportWritesSinceLastRun)
+{
+    std::vector<EntityID> ids;
+    for (int i = 0; i < 3; i++)
+    {
+        Entity *entity = stage->get_entity_manager().create_entity("E" + std::to_string(i));
+        entity->add_component<Position>();
+        ids.push_back(entity->get_id());
+    }
+
+    ChangedPositionSystem *tracker = stage->get_system_scheduler().add_system<ChangedPositionSystem>();
+
+    stage->update(0.0f);
+    EXPECT_EQ(tracker->changed, 3u);
+
+    stage->update(0.0f);
+    EXPECT_EQ(tracker->changed, 0u);
+
+    // Written between frames, after the tracker's last run
+    stage->get_component_manager().get_component<Position>(ids[1])->x = 5.0f;
+    stage->get_component_manager().read_component<Position>(ids[2]);
+
+    stage->update(0.0f);
+    EXPECT_EQ(tracker->changed, 1u);
+}